@@ -4,10 +4,42 @@
 
 #include <benchmark/benchmark.h>
 
+#include <lexertk/dfa_generator.hpp>
 #include <lexertk/generator.hpp>
+#include <lexertk/generator_pool.hpp>
 
 #include "lexertk_original.hpp"
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory_resource>
+#include <string>
+#include <variant>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#endif
+
+// Time stamp counter ticks (reference cycles), zero where there is none.
+static std::uint64_t cycle_count() {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+// Reports tokens per second and the cycles spent per token.
+static void set_token_counters(benchmark::State& state, std::size_t tokens_per_iteration, std::uint64_t cycles) {
+  auto tokens = static_cast<double>(tokens_per_iteration) * static_cast<double>(state.iterations());
+  state.counters["tokens"] = benchmark::Counter(tokens, benchmark::Counter::kIsRate);
+  state.counters["cycles/token"] = static_cast<double>(cycles) / tokens;
+}
+
 
 static void BM_RefactoredLexer(benchmark::State& state) {
   constexpr static std::string_view expression = "{a+(b-[c*(e/{f+g}-h)*i]%[j+(k-{l*m}/n)+o]-p)*q}";
@@ -23,6 +55,19 @@ static void BM_RefactoredLexer(benchmark::State& state) {
   }
 }
 
+static void BM_DfaLexer(benchmark::State& state) {
+  constexpr static std::string_view expression = "{a+(b-[c*(e/{f+g}-h)*i]%[j+(k-{l*m}/n)+o]-p)*q}";
+
+  lexertk::dfa_generator generator;
+
+  for (auto _ : state) {
+    generator.process(expression);
+
+    benchmark::DoNotOptimize(std::move(generator).get_token_list());
+    benchmark::ClobberMemory();
+  }
+}
+
 static void BM_OriginalLexer(benchmark::State& state) {
   std::string expression = "{a+(b-[c*(e/{f+g}-h)*i]%[j+(k-{l*m}/n)+o]-p)*q}";
 
@@ -37,8 +82,339 @@ static void BM_OriginalLexer(benchmark::State& state) {
   }
 }
 
+static constexpr std::string_view indented_expression =
+    "{\n"
+    "        a + (\n"
+    "                b - [c * (e / {f + g} - h) * i]\n"
+    "                    % [j + (k - {l * m} / n) + o]\n"
+    "                - p\n"
+    "            )\n"
+    "            * q\n"
+    "}\n";
+
+static void BM_RefactoredLexerIndented(benchmark::State& state) {
+  lexertk::generator generator;
+
+  for (auto _ : state) {
+    generator.process(indented_expression);
+
+    benchmark::DoNotOptimize(std::move(generator).get_token_list());
+    benchmark::ClobberMemory();
+  }
+}
+
+static void BM_RefactoredLexerIndentedPadded(benchmark::State& state) {
+  std::string buffer{indented_expression};
+  auto input = lexertk::padded_input::pad(buffer);
+
+  lexertk::generator generator;
+
+  for (auto _ : state) {
+    generator.process(input);
+
+    benchmark::DoNotOptimize(std::move(generator).get_token_list());
+    benchmark::ClobberMemory();
+  }
+}
+
+static void BM_DfaLexerIndented(benchmark::State& state) {
+  lexertk::dfa_generator generator;
+
+  for (auto _ : state) {
+    generator.process(indented_expression);
+
+    benchmark::DoNotOptimize(std::move(generator).get_token_list());
+    benchmark::ClobberMemory();
+  }
+}
+
+static void BM_OriginalLexerIndented(benchmark::State& state) {
+  std::string expression{indented_expression};
+
+  original::lexertk::generator generator;
+
+  for (auto _ : state) {
+    generator.process(expression);
+
+    benchmark::DoNotOptimize(generator);
+    benchmark::ClobberMemory();
+  }
+}
+
+// Every token class, comments and line breaks, so the scanner dispatch sees
+// the kind of unpredictable sequence of first bytes real input has.
+static constexpr std::string_view mixed_expression =
+    "total := price * 1.5e3 + 'label' # trailing comment\n"
+    "if (qty >= 10 && side != 'sell') /* block */ x[i] << 2;\n"
+    "y = f(a, b) - 0.25 // ratio\n"
+    "z::w = \"say \\\"hi\\\"\" || flag == true;\n";
+
+static void BM_RefactoredLexerMixed(benchmark::State& state) {
+  lexertk::generator generator;
+  std::size_t tokens = 0;
+
+  auto start = cycle_count();
+  for (auto _ : state) {
+    generator.process(mixed_expression);
+
+    auto list = std::move(generator).get_token_list();
+    tokens = list.size();
+    benchmark::DoNotOptimize(list);
+    benchmark::ClobberMemory();
+  }
+  set_token_counters(state, tokens, cycle_count() - start);
+}
+
+static void BM_RefactoredLexerMixedInterned(benchmark::State& state) {
+  lexertk::generator_settings settings;
+  settings.intern_symbols = true;
+  lexertk::generator generator{settings};
+  std::size_t tokens = 0;
+
+  auto start = cycle_count();
+  for (auto _ : state) {
+    generator.process(mixed_expression);
+
+    auto list = std::move(generator).get_token_list();
+    auto ids = std::move(generator).get_symbol_ids();
+    tokens = list.size();
+    benchmark::DoNotOptimize(list);
+    benchmark::DoNotOptimize(ids);
+    benchmark::ClobberMemory();
+  }
+  set_token_counters(state, tokens, cycle_count() - start);
+}
+
+static void BM_CompactLexerMixed(benchmark::State& state) {
+  lexertk::compact_generator generator;
+  std::size_t tokens = 0;
+
+  auto start = cycle_count();
+  for (auto _ : state) {
+    generator.process(mixed_expression);
+
+    auto list = std::move(generator).get_token_list();
+    tokens = list.size();
+    benchmark::DoNotOptimize(list);
+    benchmark::ClobberMemory();
+  }
+  set_token_counters(state, tokens, cycle_count() - start);
+}
+
+static void BM_SoaLexerMixed(benchmark::State& state) {
+  lexertk::soa_generator generator;
+  std::size_t tokens = 0;
+
+  auto start = cycle_count();
+  for (auto _ : state) {
+    generator.process(mixed_expression);
+
+    auto list = std::move(generator).get_token_list();
+    tokens = list.size();
+    benchmark::DoNotOptimize(list);
+    benchmark::ClobberMemory();
+  }
+  set_token_counters(state, tokens, cycle_count() - start);
+}
+
+static void BM_DfaLexerMixed(benchmark::State& state) {
+  lexertk::dfa_generator generator;
+  std::size_t tokens = 0;
+
+  auto start = cycle_count();
+  for (auto _ : state) {
+    generator.process(mixed_expression);
+
+    auto list = std::move(generator).get_token_list();
+    tokens = list.size();
+    benchmark::DoNotOptimize(list);
+    benchmark::ClobberMemory();
+  }
+  set_token_counters(state, tokens, cycle_count() - start);
+}
+
+static void BM_OriginalLexerMixed(benchmark::State& state) {
+  std::string expression{mixed_expression};
+
+  original::lexertk::generator generator;
+
+  auto start = cycle_count();
+  for (auto _ : state) {
+    generator.process(expression);
+
+    benchmark::DoNotOptimize(generator);
+    benchmark::ClobberMemory();
+  }
+  set_token_counters(state, generator.size(), cycle_count() - start);
+}
+
+static constexpr std::string_view numeric_expression =
+    "x := 3.14159 * r^2 + 42 - 1.5e-3 * (7 + 128) / 0.125 + 65536 * 2.71828e+2;\n"
+    "y := 1024 + 0.5 * 99.9 - 3e8 / 299792458 + 12345678901 * 1.0e-10;\n";
+
+// Every number token converted after lexing, the way consumers used to.
+static void BM_RefactoredLexerNumbersStrtod(benchmark::State& state) {
+  lexertk::generator generator;
+  double sum = 0;
+
+  for (auto _ : state) {
+    generator.process(numeric_expression);
+
+    auto list = std::move(generator).get_token_list();
+    for (auto const& t : list) {
+      if (t.get_type() == lexertk::token::token_type::number) {
+        sum += std::strtod(std::string(t.get_value()).c_str(), nullptr);
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+    benchmark::ClobberMemory();
+  }
+}
+
+static void BM_RefactoredLexerNumbersParsed(benchmark::State& state) {
+  lexertk::generator_settings settings;
+  settings.parse_numbers = true;
+  lexertk::generator generator{settings};
+  double sum = 0;
+
+  for (auto _ : state) {
+    generator.process(numeric_expression);
+
+    auto list = std::move(generator).get_token_list();
+    for (auto const& n : std::move(generator).get_numbers()) {
+      sum += std::visit([](auto v) { return static_cast<double>(v); }, n.value);
+    }
+    benchmark::DoNotOptimize(list);
+    benchmark::DoNotOptimize(sum);
+    benchmark::ClobberMemory();
+  }
+}
+
+static constexpr std::string_view escaped_expression =
+    "print('first line\\nsecond line', \"column\\tcolumn\\tcolumn\", 'it\\'s a quoted word',\n"
+    "      \"say \\\"hello there\\\" twice\", 'C:\\\\temp\\\\lexer\\\\out.txt', 'no escapes at all')\n";
+
+// A file of escaped strings decoded by the caller, one std::string each.
+static void BM_RefactoredLexerEscapesCleanup(benchmark::State& state) {
+  std::size_t bytes = 0;
+
+  for (auto _ : state) {
+    lexertk::generator generator;
+    for (int line = 0; line < 64; ++line) {
+      generator.process(escaped_expression);
+    }
+
+    for (auto const& t : generator.get_token_list()) {
+      if (t.get_type() == lexertk::token::token_type::string_with_escapes) {
+        auto decoded = lexertk::details::cleanup_escapes(t.get_value());
+        bytes += decoded.size();
+        benchmark::DoNotOptimize(decoded);
+      }
+    }
+    benchmark::ClobberMemory();
+  }
+  benchmark::DoNotOptimize(bytes);
+}
+
+static void BM_RefactoredLexerEscapesDecoded(benchmark::State& state) {
+  lexertk::generator_settings settings;
+  settings.decode_strings = true;
+  std::size_t bytes = 0;
+
+  for (auto _ : state) {
+    lexertk::generator generator{settings};
+    for (int line = 0; line < 64; ++line) {
+      generator.process(escaped_expression);
+    }
+
+    for (auto const& t : generator.get_token_list()) {
+      if (t.get_type() == lexertk::token::token_type::string_with_escapes) {
+        bytes += t.get_value().size();
+      }
+    }
+    benchmark::ClobberMemory();
+  }
+  benchmark::DoNotOptimize(bytes);
+}
+
+// One short expression per request, lexed by a fresh generator like
+// parser_helper::init did before it leased pooled ones.
+constexpr static std::string_view short_expression = "x := max(a + 2 * b, c - 1) / (d + 0.5)";
+
+static void BM_RefactoredLexerShort(benchmark::State& state) {
+  for (auto _ : state) {
+    lexertk::generator generator;
+    generator.process(short_expression);
+    benchmark::DoNotOptimize(generator.get_token_list().size());
+  }
+}
+
+static void BM_SmallLexerShort(benchmark::State& state) {
+  for (auto _ : state) {
+    lexertk::small_generator generator;
+    generator.process(short_expression);
+    benchmark::DoNotOptimize(generator.get_token_list().size());
+  }
+}
+
+// The same expressions lexed by one long-lived generator.
+static void BM_RefactoredLexerShortReset(benchmark::State& state) {
+  lexertk::generator generator;
+
+  for (auto _ : state) {
+    generator.reset();
+    generator.process(short_expression);
+    benchmark::DoNotOptimize(generator.get_token_list().size());
+  }
+}
+
+// A fresh generator per expression whose tokens live in a per-request arena.
+static void BM_RefactoredLexerShortArena(benchmark::State& state) {
+  alignas(lexertk::token) std::array<std::byte, 4096> buffer;
+
+  for (auto _ : state) {
+    std::pmr::monotonic_buffer_resource arena{buffer.data(), buffer.size()};
+    lexertk::generator generator{{}, &arena};
+    generator.process(short_expression);
+    benchmark::DoNotOptimize(generator.get_token_list().size());
+  }
+}
+
+// Generators leased from the thread's pool, the token list handed back after use.
+static void BM_RefactoredLexerShortPooled(benchmark::State& state) {
+  auto& pool = lexertk::generator_pool::local();
+
+  for (auto _ : state) {
+    auto generator = pool.acquire();
+    generator->process(short_expression);
+    auto tokens = std::move(*generator).get_token_list();
+    benchmark::DoNotOptimize(tokens.size());
+    pool.recycle(std::move(tokens));
+  }
+}
+
 BENCHMARK(BM_OriginalLexer);
 BENCHMARK(BM_RefactoredLexer);
+BENCHMARK(BM_DfaLexer);
+BENCHMARK(BM_OriginalLexerIndented);
+BENCHMARK(BM_RefactoredLexerIndented);
+BENCHMARK(BM_RefactoredLexerIndentedPadded);
+BENCHMARK(BM_DfaLexerIndented);
+BENCHMARK(BM_OriginalLexerMixed);
+BENCHMARK(BM_RefactoredLexerMixed);
+BENCHMARK(BM_RefactoredLexerMixedInterned);
+BENCHMARK(BM_CompactLexerMixed);
+BENCHMARK(BM_SoaLexerMixed);
+BENCHMARK(BM_DfaLexerMixed);
+BENCHMARK(BM_RefactoredLexerNumbersStrtod);
+BENCHMARK(BM_RefactoredLexerNumbersParsed);
+BENCHMARK(BM_RefactoredLexerEscapesCleanup);
+BENCHMARK(BM_RefactoredLexerEscapesDecoded);
+BENCHMARK(BM_RefactoredLexerShort);
+BENCHMARK(BM_SmallLexerShort);
+BENCHMARK(BM_RefactoredLexerShortReset);
+BENCHMARK(BM_RefactoredLexerShortArena);
+BENCHMARK(BM_RefactoredLexerShortPooled);
 
 // Run the benchmark
 BENCHMARK_MAIN();
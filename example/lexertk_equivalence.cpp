@@ -0,0 +1,196 @@
+//
+// Created by allspark on 17/10/2026.
+//
+
+// Lexes one corpus through every scanner kernel level the CPU supports, the
+// padded_input path, lazy positions and dfa_generator, and checks that all of
+// them produce the token stream of the scalar generator.
+
+#include <lexertk/lexertk.hpp>
+
+#include <fmt/format.h>
+
+#include <cstddef>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+struct lexed_token
+{
+  lexertk::token::token_type type;
+  std::string value;
+  std::size_t line;
+  std::size_t column;
+
+  bool operator==(lexed_token const&) const = default;
+};
+
+struct lexed
+{
+  bool ok{false};
+  std::vector<lexed_token> tokens;
+
+  bool operator==(lexed const&) const = default;
+};
+
+template <typename Generator, typename Input>
+lexed lex(Generator& generator, Input input)
+{
+  lexed result;
+  result.ok = generator.process(input);
+  for (auto const& t : generator.get_token_list())
+  {
+    auto position = generator.resolve_position(t);
+    result.tokens.push_back({t.get_type(), std::string{t.get_value()}, position.line, position.column});
+  }
+  return result;
+}
+
+template <typename Generator>
+lexed lex(lexertk::generator_settings settings, std::string const& input)
+{
+  Generator generator{settings};
+  return lex(generator, std::string_view{input});
+}
+
+lexed lex_padded(lexertk::generator_settings settings, std::string const& input)
+{
+  std::string buffer = input;
+  lexertk::generator generator{settings};
+  return lex(generator, lexertk::padded_input::pad(buffer));
+}
+
+// Random expressions built from tokens and from byte soups, and runs of every
+// length around the 16, 32 and 64 byte blocks of the kernels.
+std::vector<std::string> make_corpus()
+{
+  static const std::vector<std::string> pieces = {
+      "a", "b", "x_y", "portfolio_exposure_usd_eod", "abcdefghijklmnopqrstuvwxyz0123456789_abcdefghij", "true", "false", "e", "E1",
+      "0", "1", "123", "1.5", "1.2.3", "1e5", "1E+5", "1e-", "1e+-2", "1e5e3", "1.e", "7e", "3ex", "12345678901234567890123456789012345.5e-10",
+      "+", "-", "*", "/", "^", "<", ">", "=", "<=", ">=", "<>", "!=", "==", ":=", "<<", ">>", "::", "&&", "||", ",", "!", "(", ")", "[", "]", "{", "}", "%", ":", "?", "&", "|", ";", "#", ".", "~",
+      " ", "  ", "\t", "\n", "\r\n", "                                        ", "\n    \n        ", "\v\f\b",
+      "'", "\"", "'abc'", "\"hello world\"", "'a\\'b'", "'\\\\'", "'\\n\\t'", "'\\x41\\u00e9'", "'a long string literal with many characters in it to cross 32 byte blocks {\\\"k\\\":1}'",
+      "//", "// comment\n", "/*", "*/", "/* block \n comment */", "# hash comment\n", "/* a */ /* b */", "//x\n//y\n", "\\", "$", "@", "_", "`", "\x80", "\xff"};
+  static const std::vector<std::string> soups = {"aa\\\\'\" ", "a1_ \n\t", "/*#a\n ", "1234567890.eE+-a", "a=<>!:&|+-*/", "ab'\\\"/*# \n1.e+_", std::string("a1 #/\0.e+'", 11)};
+
+  std::vector<std::string> corpus;
+  std::mt19937 rng(12345);
+  for (int i = 0; i < 10000; ++i)
+  {
+    std::string input;
+    if (i % 2)
+    {
+      for (auto k = rng() % 12 + 1; k > 0; --k)
+      {
+        input += pieces[rng() % pieces.size()];
+      }
+    }
+    else
+    {
+      auto const& soup = soups[rng() % soups.size()];
+      for (auto k = rng() % 150; k > 0; --k)
+      {
+        input += soup[rng() % soup.size()];
+      }
+    }
+    corpus.push_back(std::move(input));
+  }
+
+  for (std::size_t n = 1; n <= 130; ++n)
+  {
+    corpus.push_back(std::string(n, 'a') + "+1");
+    corpus.push_back(std::string(n, ' ') + "x");
+    corpus.push_back(std::string(n, '7') + ".5e3 y");
+    corpus.push_back("'" + std::string(n, 's') + "\\n" + std::string(n % 7, 't') + "' z");
+    corpus.push_back("/*" + std::string(n, '*') + "*/ w");
+    corpus.push_back("// " + std::string(n, 'c') + "\nv");
+  }
+  return corpus;
+}
+
+std::string printable(std::string_view text)
+{
+  std::string result;
+  for (unsigned char c : text)
+  {
+    result += (c < 32 || c > 126) ? fmt::format("\\x{:02x}", c) : std::string(1, static_cast<char>(c));
+  }
+  return result;
+}
+
+void print_tokens(std::string_view name, lexed const& l)
+{
+  fmt::print("  {} ok={}:", name, l.ok);
+  for (auto const& t : l.tokens)
+  {
+    fmt::print(" {}({},{})[{}]", lexertk::to_string(t.type), t.line, t.column, printable(t.value));
+  }
+  fmt::print("\n");
+}
+}  // namespace
+
+int main()
+{
+  const auto corpus = make_corpus();
+  const auto detected = lexertk::detected_isa_level();
+  std::size_t failures = 0;
+
+  auto check = [&](std::string_view name, std::string const& input, lexed const& expected, lexed const& actual)
+  {
+    if (expected == actual)
+    {
+      return;
+    }
+    if (++failures <= 10)
+    {
+      fmt::print("{} differs from the scalar generator for [{}]\n", name, printable(input));
+      print_tokens("scalar", expected);
+      print_tokens(name, actual);
+    }
+  };
+
+  lexertk::generator_settings with_hash;
+  lexertk::generator_settings without_hash;
+  without_hash.hash_as_comment = false;
+  lexertk::generator_settings decoded;
+  decoded.decode_strings = true;
+
+  for (auto const& settings : {with_hash, without_hash, decoded})
+  {
+    lexertk::force_isa_level(lexertk::isa_level::scalar);
+    std::vector<lexed> reference;
+    for (auto const& input : corpus)
+    {
+      reference.push_back(lex<lexertk::generator>(settings, input));
+    }
+
+    for (auto level : {lexertk::isa_level::scalar, lexertk::isa_level::sse4_2, lexertk::isa_level::avx2, lexertk::isa_level::avx512})
+    {
+      if (lexertk::force_isa_level(level) != level)
+      {
+        fmt::print("{} is not supported by this CPU, skipped\n", lexertk::to_string(level));
+        continue;
+      }
+
+      auto lazy = settings;
+      lazy.lazy_position = true;
+      const auto at = fmt::format(" at {}", lexertk::to_string(level));
+      for (std::size_t i = 0; i < corpus.size(); ++i)
+      {
+        auto const& input = corpus[i];
+        check("generator" + at, input, reference[i], lex<lexertk::generator>(settings, input));
+        check("padded generator" + at, input, reference[i], lex_padded(settings, input));
+        check("lazy generator" + at, input, reference[i], lex<lexertk::generator>(lazy, input));
+        check("dfa_generator" + at, input, reference[i], lex<lexertk::dfa_generator>(settings, input));
+      }
+    }
+  }
+  lexertk::force_isa_level(detected);
+
+  fmt::print("{} inputs, {} mismatches\n", corpus.size(), failures);
+  return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,174 @@
+//
+// Created by allspark on 17/10/2026.
+//
+
+// Checks that the values of decoded strings and of tokens synthesized by the
+// helpers are owned by the token list: they outlive the input, the helpers
+// and the memory_resource of a list they were moved out of, and lexing into a
+// warm list does not allocate.
+
+#include <lexertk/helper.hpp>
+#include <lexertk/lexertk.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace
+{
+std::size_t allocations = 0;
+}  // namespace
+
+void* operator new(std::size_t size)
+{
+  ++allocations;
+  if (void* p = std::malloc(size == 0 ? 1 : size))
+  {
+    return p;
+  }
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+namespace
+{
+std::size_t failures = 0;
+
+void expect(bool condition, std::string_view what)
+{
+  if (!condition)
+  {
+    ++failures;
+    fmt::print("FAILED: {}\n", what);
+  }
+}
+
+std::vector<std::string> values_of(lexertk::token_list const& list)
+{
+  std::vector<std::string> values;
+  for (auto const& t : list)
+  {
+    values.emplace_back(t.get_value());
+  }
+  return values;
+}
+
+// Lexes input with decode_strings and runs the helpers on the tokens, the
+// list allocates from resource.
+lexertk::token_list lex_and_rewrite(std::string_view input, std::pmr::memory_resource* resource)
+{
+  lexertk::generator_settings settings;
+  settings.decode_strings = true;
+  lexertk::generator generator{settings, resource};
+  generator.process(input);
+  auto list = std::move(generator).get_token_list();
+
+  lexertk::helper::symbol_replacer replacer;
+  replacer.add_replace("pi", "pi_" + std::string(40, 'p'));
+  replacer.add_replace("e", std::string(64, 'e'));
+  lexertk::helper::operator_joiner joiner;
+  lexertk::helper::commutative_inserter inserter;
+
+  lexertk::helper::helper_assembly assembly;
+  assembly.register_modifier(&replacer);
+  assembly.register_joiner(&joiner);
+  assembly.register_inserter(&inserter);
+  assembly.run_modifiers(list);
+  assembly.run_joiners(list);
+  assembly.run_inserters(list);
+  return list;
+}
+
+void values_outlive_their_sources()
+{
+  const std::vector<std::string> expected = {"2", "*", "pi_" + std::string(40, 'p'), "<>", std::string(64, 'e'), "+", "a\tb", "+", "c\nd\\e", ""};
+  // the values that are not views of the input
+  const std::vector<std::size_t> owned = {1, 2, 3, 4, 6, 8};
+
+  std::string input = "2pi < > e + 'a\\tb' + \"c\\nd\\\\e\"";
+  alignas(std::max_align_t) std::array<std::byte, 8192> buffer;
+  lexertk::token_list moved;
+  {
+    std::pmr::monotonic_buffer_resource arena{buffer.data(), buffer.size(), std::pmr::null_memory_resource()};
+    auto list = lex_and_rewrite(input, &arena);
+    // the helpers are gone already
+    expect(values_of(list) == expected, "values outlive the helpers");
+
+    // the default resource of moved is not equal to arena, the tokens and
+    // their values are copied
+    moved = std::move(list);
+  }
+  std::fill(buffer.begin(), buffer.end(), std::byte{'?'});
+  expect(values_of(moved) == expected, "values follow a move into a list with another resource");
+
+  // equal resources, the arena of the list is taken along
+  lexertk::token_list taken;
+  taken = std::move(moved);
+  expect(values_of(taken) == expected, "values follow a move into a list with an equal resource");
+
+  lexertk::token_list copy{taken};
+  taken.clear();
+  expect(values_of(copy) == expected, "values of a copy are its own");
+
+  std::fill(input.begin(), input.end(), '?');
+  input.clear();
+  input.shrink_to_fit();
+  expect(std::all_of(owned.begin(), owned.end(), [&](std::size_t i) { return copy[i].get_value() == expected[i]; }), "values outlive the input");
+}
+
+void warm_lists_do_not_allocate()
+{
+  const std::string input = "x := 'a\\tb' + 2y + 'c\\u00e9'";
+  lexertk::generator_settings settings;
+  settings.decode_strings = true;
+  lexertk::generator generator{settings};
+  lexertk::helper::operator_joiner joiner;
+  lexertk::helper::commutative_inserter inserter;
+  lexertk::helper::helper_assembly assembly;
+  assembly.register_joiner(&joiner);
+  assembly.register_inserter(&inserter);
+
+  std::size_t steady = 0;
+  for (int round = 0; round < 8; ++round)
+  {
+    auto before = allocations;
+    generator.process(input);
+    auto list = std::move(generator).get_token_list();
+    assembly.run_joiners(list);
+    assembly.run_inserters(list);
+    generator.reset(std::move(list));
+    if (round >= 2)
+    {
+      steady += allocations - before;
+    }
+  }
+  expect(steady == 0, "decoding and rewriting into a warm list does not allocate");
+}
+}  // namespace
+
+int main()
+{
+  values_outlive_their_sources();
+  warm_lists_do_not_allocate();
+
+  fmt::print("{} failures\n", failures);
+  return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
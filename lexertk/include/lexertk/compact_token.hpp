@@ -0,0 +1,93 @@
+//
+// Created by allspark on 16/10/2026.
+//
+
+#ifndef LEXERTK_COMPACT_TOKEN_HPP
+#define LEXERTK_COMPACT_TOKEN_HPP
+
+#include "source_map.hpp"
+#include "token.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace lexertk
+{
+// 8 byte token: offset and length of its text inside the lexed input plus its
+// type. The text is resolved against the input by the compact_token_list
+// holding the token, and positions by the generator that produced it.
+class compact_token
+{
+public:
+  using token_type = token::token_type;
+
+  static constexpr std::size_t max_length = (std::size_t{1} << 24) - 1;
+
+  compact_token() = default;
+  inline compact_token(token_type tt, std::uint32_t offset, std::uint32_t length) noexcept;
+
+  inline bool is_error() const noexcept;
+
+  inline token_type get_type() const noexcept;
+  inline std::uint32_t get_offset() const noexcept;
+  inline std::uint32_t get_length() const noexcept;
+
+  // The token's text, base being where offset 0 is located.
+  inline std::string_view get_value(const char* base) const noexcept;
+
+private:
+  std::uint32_t m_offset{0};
+  // length in the low 24 bits, type in the high 8
+  std::uint32_t m_length_type{0};
+};
+
+static_assert(sizeof(compact_token) == 8);
+
+// Token list of compact_token, offsets are resolved through a source_map. The
+// inputs must stay alive while values are looked up. Holds up to 4 GiB of
+// input, tokens of up to compact_token::max_length bytes.
+class compact_token_list
+{
+public:
+  using iterator = std::string_view::const_iterator;
+  using value_type = compact_token;
+  using const_iterator = std::vector<compact_token>::const_iterator;
+
+  // longer tokens are stored as error tokens, see emplace_back
+  static constexpr std::size_t max_token_length = compact_token::max_length;
+
+  compact_token_list() = default;
+
+  // Starts a new input, tokens emplaced after it must lie inside it.
+  inline void add_source(std::string_view text);
+
+  inline void reserve(std::size_t count);
+  // The tokens have no position, see basic_generator::resolve_position. A
+  // token longer than max_token_length becomes an error token holding its
+  // first max_token_length bytes.
+  inline void emplace_back(token::token_type type, iterator begin, iterator end, no_position);
+  inline void clear() noexcept;
+
+  inline std::size_t size() const noexcept;
+  inline std::size_t capacity() const noexcept;
+  inline bool empty() const noexcept;
+  inline const_iterator begin() const noexcept;
+  inline const_iterator end() const noexcept;
+  inline compact_token const& operator[](std::size_t i) const noexcept;
+  inline compact_token const& back() const noexcept;
+
+  // Where the text of a token of this list starts in its input.
+  inline const char* location_of(compact_token const& t) const noexcept;
+  inline std::string_view value_of(compact_token const& t) const noexcept;
+
+private:
+  std::vector<compact_token> m_tokens;
+  source_map m_sources;
+};
+}  // namespace lexertk
+
+#include "compact_token.ipp"
+
+#endif  //LEXERTK_COMPACT_TOKEN_HPP
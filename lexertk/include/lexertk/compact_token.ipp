@@ -0,0 +1,115 @@
+//
+// Created by allspark on 16/10/2026.
+//
+
+#ifndef LEXERTK_COMPACT_TOKEN_IPP
+#define LEXERTK_COMPACT_TOKEN_IPP
+
+namespace lexertk
+{
+compact_token::compact_token(token_type tt, std::uint32_t offset, std::uint32_t length) noexcept
+  : m_offset{offset}
+  , m_length_type{length | (static_cast<std::uint32_t>(tt) << 24)}
+{
+}
+
+bool compact_token::is_error() const noexcept
+{
+  return lexertk::is_error(get_type());
+}
+
+compact_token::token_type compact_token::get_type() const noexcept
+{
+  return static_cast<token_type>(m_length_type >> 24);
+}
+
+std::uint32_t compact_token::get_offset() const noexcept
+{
+  return m_offset;
+}
+
+std::uint32_t compact_token::get_length() const noexcept
+{
+  return m_length_type & static_cast<std::uint32_t>(max_length);
+}
+
+std::string_view compact_token::get_value(const char* base) const noexcept
+{
+  return {base + m_offset, get_length()};
+}
+
+void compact_token_list::add_source(std::string_view text)
+{
+  m_sources.add(text);
+}
+
+void compact_token_list::reserve(std::size_t count)
+{
+  m_tokens.reserve(count);
+}
+
+void compact_token_list::emplace_back(token::token_type type, iterator begin, iterator end, no_position)
+{
+  auto length = static_cast<std::size_t>(std::distance(begin, end));
+  if (length > max_token_length)
+  {
+    type = token::token_type::error;
+    length = max_token_length;
+  }
+
+  m_tokens.emplace_back(type, m_sources.offset_of(std::to_address(begin)), static_cast<std::uint32_t>(length));
+}
+
+void compact_token_list::clear() noexcept
+{
+  m_tokens.clear();
+  m_sources.clear();
+}
+
+std::size_t compact_token_list::size() const noexcept
+{
+  return m_tokens.size();
+}
+
+std::size_t compact_token_list::capacity() const noexcept
+{
+  return m_tokens.capacity();
+}
+
+bool compact_token_list::empty() const noexcept
+{
+  return m_tokens.empty();
+}
+
+compact_token_list::const_iterator compact_token_list::begin() const noexcept
+{
+  return m_tokens.begin();
+}
+
+compact_token_list::const_iterator compact_token_list::end() const noexcept
+{
+  return m_tokens.end();
+}
+
+compact_token const& compact_token_list::operator[](std::size_t i) const noexcept
+{
+  return m_tokens[i];
+}
+
+compact_token const& compact_token_list::back() const noexcept
+{
+  return m_tokens.back();
+}
+
+const char* compact_token_list::location_of(compact_token const& t) const noexcept
+{
+  return m_sources.location_of(t.get_offset());
+}
+
+std::string_view compact_token_list::value_of(compact_token const& t) const noexcept
+{
+  return {location_of(t), t.get_length()};
+}
+}  // namespace lexertk
+
+#endif  //LEXERTK_COMPACT_TOKEN_IPP
@@ -0,0 +1,144 @@
+//
+// Created by allspark on 16/10/2026.
+//
+
+#ifndef LEXERTK_CPU_FEATURES_HPP
+#define LEXERTK_CPU_FEATURES_HPP
+
+#include <cstdint>
+#include <string_view>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#  define LEXERTK_SIMD_DISPATCH
+#  if defined(_MSC_VER) && !defined(__clang__)
+#    include <intrin.h>
+#  else
+#    include <cpuid.h>
+#  endif
+#endif
+
+namespace lexertk
+{
+// Instruction set levels the scanner kernels are built for, in increasing order.
+enum class isa_level : std::uint8_t
+{
+  scalar,
+  sse4_2,  // SSE4.2 and POPCNT
+  avx2,    // AVX2, BMI1/2 and POPCNT
+  avx512,  // AVX-512 F/BW on top of avx2
+};
+
+constexpr std::string_view to_string(isa_level level) noexcept
+{
+  switch (level)
+  {
+    case isa_level::scalar:
+      return "scalar";
+    case isa_level::sse4_2:
+      return "sse4.2";
+    case isa_level::avx2:
+      return "avx2";
+    case isa_level::avx512:
+      return "avx512";
+  }
+  return "unknown";
+}
+
+namespace details
+{
+namespace cpu
+{
+#if defined(LEXERTK_SIMD_DISPATCH)
+struct cpuid_result
+{
+  std::uint32_t eax{0};
+  std::uint32_t ebx{0};
+  std::uint32_t ecx{0};
+  std::uint32_t edx{0};
+};
+
+inline cpuid_result cpuid(std::uint32_t leaf, std::uint32_t subleaf = 0) noexcept
+{
+  cpuid_result r;
+#  if defined(_MSC_VER) && !defined(__clang__)
+  int regs[4];
+  __cpuidex(regs, static_cast<int>(leaf), static_cast<int>(subleaf));
+  r = {static_cast<std::uint32_t>(regs[0]), static_cast<std::uint32_t>(regs[1]), static_cast<std::uint32_t>(regs[2]),
+      static_cast<std::uint32_t>(regs[3])};
+#  else
+  __cpuid_count(leaf, subleaf, r.eax, r.ebx, r.ecx, r.edx);
+#  endif
+  return r;
+}
+
+// XCR0, the register state the operating system saves on context switches.
+// Only valid if cpuid reports OSXSAVE.
+inline std::uint64_t xcr0() noexcept
+{
+#  if defined(_MSC_VER) && !defined(__clang__)
+  return _xgetbv(0);
+#  else
+  std::uint32_t lo = 0;
+  std::uint32_t hi = 0;
+  __asm__("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+  return (static_cast<std::uint64_t>(hi) << 32) | lo;
+#  endif
+}
+
+constexpr bool has_bit(std::uint32_t reg, int bit) noexcept
+{
+  return (reg >> bit) & 1u;
+}
+
+inline isa_level detect() noexcept
+{
+  if (cpuid(0).eax < 7)
+  {
+    return isa_level::scalar;
+  }
+
+  auto const leaf1 = cpuid(1);
+  auto const leaf7 = cpuid(7);
+
+  if (!has_bit(leaf1.ecx, 20) || !has_bit(leaf1.ecx, 23))  // SSE4.2, POPCNT
+  {
+    return isa_level::scalar;
+  }
+
+  // the wide registers are only usable if the OS preserves them (XCR0 bits 1/2 XMM/YMM, 5-7 AVX-512 state)
+  std::uint64_t const os_state = has_bit(leaf1.ecx, 27) ? xcr0() : 0;  // OSXSAVE
+  bool const os_avx = (os_state & 0x06) == 0x06;
+  bool const os_avx512 = (os_state & 0xE6) == 0xE6;
+
+  if (!os_avx || !has_bit(leaf1.ecx, 28) || !has_bit(leaf7.ebx, 5) || !has_bit(leaf7.ebx, 3) || !has_bit(leaf7.ebx, 8))  // AVX, AVX2, BMI1, BMI2
+  {
+    return isa_level::sse4_2;
+  }
+
+#  if defined(__x86_64__) || defined(_M_X64)
+  if (os_avx512 && has_bit(leaf7.ebx, 16) && has_bit(leaf7.ebx, 30))  // AVX512F, AVX512BW
+  {
+    return isa_level::avx512;
+  }
+#  endif
+
+  return isa_level::avx2;
+}
+#else
+inline isa_level detect() noexcept
+{
+  return isa_level::scalar;
+}
+#endif
+}  // namespace cpu
+}  // namespace details
+
+// The best level supported by this CPU and operating system, probed once.
+inline isa_level detected_isa_level() noexcept
+{
+  static isa_level const level = details::cpu::detect();
+  return level;
+}
+}  // namespace lexertk
+
+#endif  //LEXERTK_CPU_FEATURES_HPP
@@ -8,51 +8,93 @@
 #include <algorithm>
 #include <array>
 #include <cctype>
+#include <cstdint>
+#include <string>
+#include <string_view>
 
 namespace lexertk
 {
 namespace details
 {
+namespace char_class
+{
+enum : std::uint8_t
+{
+  none = 0x00,
+  whitespace = 0x01,
+  operator_char = 0x02,
+  letter = 0x04,
+  digit = 0x08,
+  string_delimiter = 0x10,
+  symbol_char = 0x20,
+  valid = 0x40,
+
+  // exactly one of these is set for every character a token can start with
+  leading = whitespace | operator_char | letter | digit | string_delimiter
+};
+}  // namespace char_class
+
+inline constexpr std::array<std::uint8_t, 256> char_class_table = []()
+{
+  std::array<std::uint8_t, 256> table{};
+
+  auto add = [&table](std::string_view chars, std::uint8_t cls)
+  {
+    for (char c : chars)
+    {
+      table[static_cast<unsigned char>(c)] |= cls;
+    }
+  };
+
+  add(" \n\r\t\b\v\f", char_class::whitespace | char_class::valid);
+  add("+-*/^<>=,!()[]{}%:?&|;#.~", char_class::operator_char | char_class::valid);
+  add("abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ", char_class::letter | char_class::symbol_char | char_class::valid);
+  add("0123456789", char_class::digit | char_class::symbol_char | char_class::valid);
+  add("_", char_class::symbol_char | char_class::valid);
+  add("\'\"", char_class::string_delimiter);
+  add("$\'", char_class::valid);
+
+  return table;
+}();
+
+inline std::uint8_t char_class_of(const char c) noexcept
+{
+  return char_class_table[static_cast<unsigned char>(c)];
+}
+
 inline bool is_whitespace(const char c) noexcept
 {
-  return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\b' || c == '\v' || c == '\f';
+  return char_class_of(c) & char_class::whitespace;
 }
 
 inline bool is_operator_char(const char c) noexcept
 {
-  return '+' == c || '-' == c ||
-      '*' == c || '/' == c ||
-      '^' == c || '<' == c ||
-      '>' == c || '=' == c ||
-      ',' == c || '!' == c ||
-      '(' == c || ')' == c ||
-      '[' == c || ']' == c ||
-      '{' == c || '}' == c ||
-      '%' == c || ':' == c ||
-      '?' == c || '&' == c ||
-      '|' == c || ';' == c ||
-      '#' == c || '.' == c ||
-      '~' == c;
+  return char_class_of(c) & char_class::operator_char;
 }
 
 inline bool is_string_delimiter(const char c) noexcept
 {
-  return c == '\'' || c == '\"';
+  return char_class_of(c) & char_class::string_delimiter;
 }
 
 inline bool is_letter(const char c) noexcept
 {
-  return ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z');
+  return char_class_of(c) & char_class::letter;
 }
 
 inline bool is_digit(const char c) noexcept
 {
-  return '0' <= c && c <= '9';
+  return char_class_of(c) & char_class::digit;
 }
 
 inline bool is_letter_or_digit(const char c) noexcept
 {
-  return is_letter(c) || is_digit(c);
+  return char_class_of(c) & (char_class::letter | char_class::digit);
+}
+
+inline bool is_symbol_char(const char c) noexcept
+{
+  return char_class_of(c) & char_class::symbol_char;
 }
 
 inline bool is_left_bracket(const char c) noexcept
@@ -77,8 +119,7 @@ inline bool is_sign(const char c) noexcept
 
 inline bool is_invalid(const char c) noexcept
 {
-  return !is_whitespace(c) && !is_operator_char(c) && !is_letter(c) && !is_digit(c) &&
-      c != '.' && c != '_' && c != '$' && c != '~' && c != '\'';
+  return !(char_class_of(c) & char_class::valid);
 }
 
 inline bool imatch(const char c1, const char c2) noexcept
@@ -111,50 +152,6 @@ struct ilesscompare
         });
   }
 };
-
-inline std::string cleanup_escapes(std::string_view s)
-{
-  std::string ret;
-  ret.reserve(s.size());
-  std::size_t removal_count{0};
-
-  for (auto it = s.begin(); it != s.end();)
-  {
-    if (*it == '\\')
-    {
-      ++removal_count;
-      if (++it == s.end())
-      {
-        break;
-      }
-      else if (*it != '\\')
-      {
-        switch (*it)
-        {
-          case 'n':
-            ret.push_back('\n');
-            ++it;
-            break;
-          case 'r':
-            ret.push_back('\r');
-            ++it;
-            break;
-          case 't':
-            ret.push_back('\t');
-            ++it;
-            break;
-        }
-        continue;
-      }
-    }
-    else
-    {
-      ret.push_back(*it++);
-    }
-  }
-
-  return ret;
-}
 }  // namespace details
 }  // namespace lexertk
 
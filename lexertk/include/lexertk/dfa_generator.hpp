@@ -0,0 +1,79 @@
+//
+// Created by allspark on 16/10/2026.
+//
+
+#ifndef LEXERTK_DFA_GENERATOR_HPP
+#define LEXERTK_DFA_GENERATOR_HPP
+
+#include "generator.hpp"
+#include "line_index.hpp"
+#include "number_value.hpp"
+#include "symbol_table.hpp"
+#include "token.hpp"
+
+namespace lexertk
+{
+// Alternative backend to generator producing the same token stream. The whole
+// token grammar is compiled into constexpr transition tables and the input is
+// lexed by a single table-driven loop instead of per-token scanner functions.
+class dfa_generator
+{
+public:
+  using token_list_t = generator::token_list_t;
+  using token_list_itr_t = generator::token_list_itr_t;
+  using Settings = generator_settings;
+
+  dfa_generator()
+    : dfa_generator(Settings{})
+  {
+  }
+  explicit dfa_generator(Settings settings)
+    : dfa_generator(settings, std::pmr::get_default_resource())
+  {
+  }
+  // The token list allocates from resource.
+  inline dfa_generator(Settings settings, std::pmr::memory_resource* resource);
+  dfa_generator(dfa_generator const&) = delete;
+  dfa_generator(dfa_generator&&) = delete;
+  dfa_generator& operator=(dfa_generator const&) = delete;
+  dfa_generator& operator=(dfa_generator&&) = delete;
+  ~dfa_generator() = default;
+
+  inline bool process(std::string_view line);
+  // Drops everything lexed so far, keeping the memory for the next inputs.
+  inline void reset();
+  // Same as reset(), lexing into the memory of buffer from now on.
+  inline void reset(token_list_t&& buffer);
+
+  inline token_list_t const& get_token_list() const & noexcept;
+  inline token_list_t get_token_list() && noexcept;
+  // Whether the token list was moved out by get_token_list() && since the
+  // last reset.
+  inline bool token_list_taken() const noexcept;
+  inline std::vector<number_value> const& get_numbers() const & noexcept;
+  inline std::vector<number_value> get_numbers() && noexcept;
+  inline symbol_table const& get_symbols() const noexcept;
+  inline std::vector<symbol_table::id_type> const& get_symbol_ids() const & noexcept;
+  inline std::vector<symbol_table::id_type> get_symbol_ids() && noexcept;
+
+  inline token::Position resolve_position(token const& t) const noexcept;
+
+private:
+  inline void pad_symbol_ids();
+
+  token_list_t m_token_list;
+  bool m_token_list_taken{false};
+  std::size_t m_line{0};
+  line_index m_line_index;
+  std::vector<number_value> m_numbers;
+  symbol_table m_symbols;
+  std::vector<symbol_table::id_type> m_symbol_ids;
+  reservation_policy m_reservation;
+
+  Settings m_settings;
+};
+}  // namespace lexertk
+
+#include "dfa_generator.ipp"
+
+#endif  //LEXERTK_DFA_GENERATOR_HPP
@@ -0,0 +1,565 @@
+//
+// Created by allspark on 16/10/2026.
+//
+
+#ifndef LEXERTK_DFA_GENERATOR_IPP
+#define LEXERTK_DFA_GENERATOR_IPP
+
+#include "operator_table.hpp"
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+namespace lexertk
+{
+namespace details
+{
+namespace dfa
+{
+// Input classes. Every operator character has a class of its own so that a
+// transition can carry the token type of a single character operator.
+namespace input
+{
+enum : std::uint8_t
+{
+  other,
+  whitespace,
+  newline,
+  letter,
+  exponent,
+  digit,
+  underscore,
+  quote,
+  backslash,
+  eof,
+  operator_base
+};
+}  // namespace input
+
+inline constexpr std::string_view operator_chars{"+-*/^<>=,!()[]{}%:?&|;#.~"};
+inline constexpr std::size_t class_count = input::operator_base + operator_chars.size();
+
+constexpr std::uint8_t operator_class(char c) noexcept
+{
+  return static_cast<std::uint8_t>(input::operator_base + operator_chars.find(c));
+}
+
+inline constexpr std::array<std::uint8_t, 256> class_table = []()
+{
+  std::array<std::uint8_t, 256> table{};
+
+  auto add = [&table](std::string_view chars, std::uint8_t cls)
+  {
+    for (char c : chars)
+    {
+      table[static_cast<unsigned char>(c)] = cls;
+    }
+  };
+
+  add(" \r\t\b\v\f", input::whitespace);
+  add("\n", input::newline);
+  add("abcdfghijklmnopqrstuvwxyzABCDFGHIJKLMNOPQRSTUVWXYZ", input::letter);
+  add("eE", input::exponent);
+  add("0123456789", input::digit);
+  add("_", input::underscore);
+  add("\'\"", input::quote);
+  add("\\", input::backslash);
+  for (char c : operator_chars)
+  {
+    table[static_cast<unsigned char>(c)] = operator_class(c);
+  }
+
+  return table;
+}();
+
+namespace action
+{
+enum : std::uint8_t
+{
+  // advance past the current byte, otherwise it is fed again to the next state
+  consume = 0x01,
+  // the consumed byte is a '\n'
+  newline = 0x02,
+  // a token starts at the current byte
+  mark = 0x04,
+  // emit the token from the mark up to the current byte plus transition::end
+  emit = 0x08,
+  // the emitted token is an error, lexing stops
+  stop = 0x10
+};
+}  // namespace action
+
+struct transition
+{
+  std::uint8_t next{0};
+  token::token_type type{token::token_type::none};
+  std::uint8_t actions{0};
+  std::int8_t end{0};
+};
+
+// Proper prefixes of the compound operators, each one becomes a state.
+struct operator_prefixes
+{
+  std::array<std::string_view, compound_operators.size() * 3> text{};
+  std::size_t size{0};
+
+  constexpr std::size_t find(std::string_view prefix) const noexcept
+  {
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      if (text[i] == prefix)
+      {
+        return i;
+      }
+    }
+    return size;
+  }
+};
+
+inline constexpr operator_prefixes prefixes = []()
+{
+  operator_prefixes result;
+  for (auto const& op : compound_operators)
+  {
+    for (std::size_t length = 1; length < op.text.size(); ++length)
+    {
+      if (result.find(op.text.substr(0, length)) == result.size)
+      {
+        result.text[result.size++] = op.text.substr(0, length);
+      }
+    }
+  }
+  return result;
+}();
+
+namespace state
+{
+enum : std::uint8_t
+{
+  start,
+  symbol,
+  string_open,
+  string_body,
+  string_escaped,
+  string_backslash,
+  slash,
+  hash,
+  line_comment,
+  block_comment,
+  block_star,
+  // number states are offset by a combination of the number flags below
+  number_base,
+  pending_exponent_base = number_base + 16,
+  operator_base = pending_exponent_base + 16,
+  finished = 0xFF
+};
+}  // namespace state
+
+namespace number
+{
+enum : std::uint8_t
+{
+  dot = 0x01,
+  exponent = 0x02,
+  exponent_sign = 0x04,
+  exponent_digit = 0x08
+};
+}  // namespace number
+
+inline constexpr std::size_t state_count = state::operator_base + prefixes.size;
+
+static_assert(state_count < state::finished, "too many operator prefixes for 8 bit states");
+
+using table_t = std::array<transition, state_count * class_count>;
+
+constexpr token::token_type operator_type(std::string_view text) noexcept
+{
+  return text.size() == 1 ? static_cast<token::token_type>(text[0]) : operator_table.find(operator_key(text));
+}
+
+// Mirrors generator::scan_number for one byte in the given number state.
+constexpr transition number_step(std::uint8_t flags, std::uint8_t cls) noexcept
+{
+  constexpr transition error{state::finished, token::token_type::err_number, action::emit | action::stop, 0};
+  constexpr transition done{state::start, token::token_type::number, action::emit, 0};
+
+  auto to = [](std::uint8_t next_flags) -> transition
+  {
+    return {static_cast<std::uint8_t>(state::number_base + next_flags), token::token_type::none, action::consume, 0};
+  };
+
+  if (cls == input::digit)
+  {
+    return to((flags & number::exponent) ? flags | number::exponent_digit : flags);
+  }
+  else if (cls == operator_class('.'))
+  {
+    return (flags & number::dot) ? error : to(flags | number::dot);
+  }
+  else if (cls == input::exponent)
+  {
+    // whether the exponent is valid depends on the byte after it
+    return {static_cast<std::uint8_t>(state::pending_exponent_base + flags), token::token_type::none, action::consume, 0};
+  }
+  else if ((cls == operator_class('+') || cls == operator_class('-')) && (flags & number::exponent) && !(flags & number::exponent_digit))
+  {
+    return (flags & number::exponent_sign) ? error : to(flags | number::exponent_sign);
+  }
+  return done;
+}
+
+constexpr table_t build_table(bool hash_as_comment) noexcept
+{
+  table_t table{};
+
+  auto row = [&table](std::uint8_t s, transition t)
+  {
+    for (std::size_t c = 0; c < class_count; ++c)
+    {
+      table[s * class_count + c] = t;
+    }
+  };
+  auto at = [&table](std::uint8_t s, std::uint8_t c) -> transition&
+  {
+    return table[s * class_count + c];
+  };
+  auto state_of = [](std::string_view prefix)
+  {
+    return static_cast<std::uint8_t>(state::operator_base + prefixes.find(prefix));
+  };
+
+  // start: skips whitespace and dispatches on the first byte of a token
+  row(state::start, {state::finished, token::token_type::error, action::mark | action::emit | action::stop, 2});
+  at(state::start, input::whitespace) = {state::start, token::token_type::none, action::consume, 0};
+  at(state::start, input::newline) = {state::start, token::token_type::none, action::consume | action::newline, 0};
+  at(state::start, input::letter) = {state::symbol, token::token_type::none, action::mark | action::consume, 0};
+  at(state::start, input::exponent) = at(state::start, input::letter);
+  at(state::start, input::digit) = {state::number_base, token::token_type::none, action::mark | action::consume, 0};
+  at(state::start, input::quote) = {state::string_open, token::token_type::none, action::mark | action::consume, 0};
+  at(state::start, input::eof) = {state::finished, token::token_type::none, 0, 0};
+  for (char c : operator_chars)
+  {
+    if (prefixes.find({&c, 1}) != prefixes.size)
+    {
+      at(state::start, operator_class(c)) = {state_of({&c, 1}), token::token_type::none, action::mark | action::consume, 0};
+    }
+    else
+    {
+      at(state::start, operator_class(c)) = {state::start, operator_type({&c, 1}), action::mark | action::emit | action::consume, 1};
+    }
+  }
+  at(state::start, operator_class('/')) = {state::slash, token::token_type::none, action::mark | action::consume, 0};
+  if (hash_as_comment)
+  {
+    at(state::start, operator_class('#')) = {state::hash, token::token_type::none, action::mark | action::consume, 0};
+  }
+
+  // symbol: [A-Za-z][A-Za-z0-9_]*
+  row(state::symbol, {state::start, token::token_type::symbol, action::emit, 0});
+  for (std::uint8_t c : {input::letter, input::exponent, input::digit, input::underscore})
+  {
+    at(state::symbol, c) = {state::symbol, token::token_type::none, action::consume, 0};
+  }
+
+  // numbers, see generator::scan_number for the accepted formats
+  for (std::uint8_t flags = 0; flags < 16; ++flags)
+  {
+    constexpr transition bad_exponent{state::finished, token::token_type::err_number, action::emit | action::stop, -1};
+
+    row(static_cast<std::uint8_t>(state::pending_exponent_base + flags), bad_exponent);
+    for (std::uint8_t c = 0; c < class_count; ++c)
+    {
+      at(static_cast<std::uint8_t>(state::number_base + flags), c) = number_step(flags, c);
+    }
+    for (std::uint8_t c : std::array<std::uint8_t, 3>{input::digit, operator_class('+'), operator_class('-')})
+    {
+      at(static_cast<std::uint8_t>(state::pending_exponent_base + flags), c) = number_step(flags | number::exponent, c);
+    }
+  }
+
+  // strings: any unescaped quote closes the literal
+  for (auto [s, type] : {std::pair{state::string_body, token::token_type::string}, std::pair{state::string_escaped, token::token_type::string_with_escapes}})
+  {
+    row(s, {s, token::token_type::none, action::consume, 0});
+    at(s, input::newline) = {s, token::token_type::none, action::consume | action::newline, 0};
+    at(s, input::quote) = {state::start, type, action::emit | action::consume, 0};
+    at(s, input::backslash) = {state::string_backslash, token::token_type::none, action::consume, 0};
+    at(s, input::eof) = {state::finished, token::token_type::err_string, action::emit | action::stop, 0};
+  }
+  row(state::string_backslash, {state::string_escaped, token::token_type::none, action::consume, 0});
+  at(state::string_backslash, input::newline) = {state::string_escaped, token::token_type::none, action::consume | action::newline, 0};
+  at(state::string_backslash, input::eof) = {state::finished, token::token_type::err_string, action::emit | action::stop, 0};
+  // the token starts after the opening quote, unless there is nothing after it
+  for (std::uint8_t c = 0; c < class_count; ++c)
+  {
+    at(state::string_open, c) = at(state::string_body, c);
+    at(state::string_open, c).actions |= action::mark;
+  }
+  at(state::string_open, input::eof) = {state::finished, token::token_type::err_string, action::emit | action::stop, 0};
+
+  // comments, a lone trailing '/' or '#' is an operator
+  row(state::slash, {state::start, operator_type("/"), action::emit, 0});
+  at(state::slash, operator_class('/')) = {state::line_comment, token::token_type::none, action::consume, 0};
+  at(state::slash, operator_class('*')) = {state::block_comment, token::token_type::none, action::consume, 0};
+
+  row(state::hash, {state::line_comment, token::token_type::none, 0, 0});
+  at(state::hash, input::eof) = {state::start, operator_type("#"), action::emit, 0};
+
+  row(state::line_comment, {state::line_comment, token::token_type::none, action::consume, 0});
+  at(state::line_comment, input::newline) = {state::start, token::token_type::none, 0, 0};
+  at(state::line_comment, input::eof) = {state::start, token::token_type::none, 0, 0};
+
+  row(state::block_comment, {state::block_comment, token::token_type::none, action::consume, 0});
+  at(state::block_comment, input::newline) = {state::block_comment, token::token_type::none, action::consume | action::newline, 0};
+  at(state::block_comment, operator_class('*')) = {state::block_star, token::token_type::none, action::consume, 0};
+  at(state::block_comment, input::eof) = {state::start, token::token_type::none, 0, 0};
+
+  row(state::block_star, at(state::block_comment, input::other));
+  at(state::block_star, input::newline) = at(state::block_comment, input::newline);
+  at(state::block_star, operator_class('*')) = {state::block_star, token::token_type::none, action::consume, 0};
+  at(state::block_star, operator_class('/')) = {state::start, token::token_type::none, action::consume, 0};
+  at(state::block_star, input::eof) = {state::start, token::token_type::none, 0, 0};
+
+  // operators: longest match over the prefix trie of the compound operators
+  for (std::size_t i = 0; i < prefixes.size; ++i)
+  {
+    std::string_view prefix = prefixes.text[i];
+    auto s = state_of(prefix);
+
+    row(s, {state::start, operator_type(prefix), action::emit, 0});
+    for (char c : operator_chars)
+    {
+      std::array<char, 4> buffer{};
+      std::copy(prefix.begin(), prefix.end(), buffer.begin());
+      buffer[prefix.size()] = c;
+      std::string_view extended{buffer.data(), prefix.size() + 1};
+
+      if (prefixes.find(extended) != prefixes.size)
+      {
+        at(s, operator_class(c)) = {state_of(extended), token::token_type::none, action::consume, 0};
+      }
+      else if (auto type = operator_type(extended); type != token::token_type::none)
+      {
+        at(s, operator_class(c)) = {state::start, type, action::emit | action::consume, 1};
+      }
+    }
+  }
+
+  return table;
+}
+
+inline constexpr table_t hash_comment_table = build_table(true);
+inline constexpr table_t hash_operator_table = build_table(false);
+
+// every operator prefix has to be an operator in its own right, the machine
+// never backtracks more than the byte that ended the token
+static_assert([]()
+{
+  for (std::size_t i = 0; i < prefixes.size; ++i)
+  {
+    if (operator_type(prefixes.text[i]) == token::token_type::none)
+    {
+      return false;
+    }
+  }
+  return true;
+}());
+}  // namespace dfa
+}  // namespace details
+
+dfa_generator::dfa_generator(Settings settings, std::pmr::memory_resource* resource)
+  : m_token_list{resource}
+  , m_line{settings.lineOffset}
+  , m_symbols{settings.symbol_lookup}
+  , m_reservation{settings.reserve_limit}
+  , m_settings{settings}
+{
+}
+
+void dfa_generator::reset()
+{
+  if (auto capacity = m_reservation.shrink_to(m_token_list.size(), m_token_list.capacity()))
+  {
+    m_token_list = token_list_t{m_token_list.get_allocator()};
+    m_token_list.reserve(capacity);
+  }
+  m_token_list.clear();
+  m_token_list_taken = false;
+  m_line = m_settings.lineOffset;
+  m_line_index.clear();
+  m_numbers.clear();
+  m_symbols.clear();
+  m_symbol_ids.clear();
+}
+
+void dfa_generator::reset(token_list_t&& buffer)
+{
+  reset();
+  m_token_list = std::move(buffer);
+  m_token_list.clear();
+}
+
+bool dfa_generator::process(std::string_view line)
+{
+  namespace dfa = details::dfa;
+
+  ++m_line;
+  if (m_settings.lazy_position)
+  {
+    m_line_index.add(line, m_line);
+  }
+  const std::size_t first_token = m_token_list.size();
+  if (auto capacity = m_reservation.reserve_for(line.size(), first_token, m_token_list.capacity()))
+  {
+    m_token_list.reserve(capacity);
+  }
+  if (m_settings.intern_symbols)
+  {
+    m_symbol_ids.reserve(m_token_list.capacity());
+  }
+
+  auto const& table = m_settings.hash_as_comment ? dfa::hash_comment_table : dfa::hash_operator_table;
+  // decoded strings carry their position even with lazy_position
+  const bool track_position = !m_settings.lazy_position || m_settings.decode_strings;
+
+  const char* it = line.data();
+  const char* const end = it + line.size();
+  const char* line_start = it;
+  const char* token_begin = it;
+  token::Position token_position{};
+  std::uint8_t state = dfa::state::start;
+
+  while (state != dfa::state::finished)
+  {
+    auto cls = (it != end) ? dfa::class_table[static_cast<unsigned char>(*it)] : static_cast<std::uint8_t>(dfa::input::eof);
+    auto const& t = table[state * dfa::class_count + cls];
+
+    if (t.actions & dfa::action::mark)
+    {
+      token_begin = it;
+      if (track_position)
+      {
+        token_position = {static_cast<token::Position::value_type>(m_line), static_cast<token::Position::value_type>(1 + (it - line_start))};
+      }
+    }
+
+    if (t.actions & dfa::action::emit)
+    {
+      std::string_view value{token_begin, (t.end > end - it) ? end : it + t.end};
+      auto type = (t.type == token::token_type::symbol) ? m_settings.keywords.classify(value) : t.type;
+      if (type == token::token_type::number && m_settings.parse_numbers)
+      {
+        number_value number{m_token_list.size(), {}};
+        if (!details::convert_number(value, number.value))
+        {
+          m_token_list.emplace_back(token::token_type::err_number, value, token_position);
+          pad_symbol_ids();
+          m_reservation.record(line.size(), m_token_list.size() - first_token);
+          return false;
+        }
+        m_numbers.push_back(number);
+      }
+      else if (type == token::token_type::symbol && m_settings.intern_symbols)
+      {
+        m_symbol_ids.resize(m_token_list.size(), symbol_table::npos);
+        m_symbol_ids.push_back(m_symbols.intern(value));
+      }
+      else if (type == token::token_type::string_with_escapes && m_settings.decode_strings)
+      {
+        value = m_token_list.store_value(value.size(), [value](char* out) { return details::decode_escapes(value, out); });
+      }
+      m_token_list.emplace_back(type, value, token_position);
+
+      if (t.actions & dfa::action::stop)
+      {
+        pad_symbol_ids();
+        m_reservation.record(line.size(), m_token_list.size() - first_token);
+        return false;
+      }
+    }
+
+    if (t.actions & dfa::action::consume)
+    {
+      if (t.actions & dfa::action::newline)
+      {
+        ++m_line;
+        line_start = it + 1;
+      }
+      ++it;
+    }
+
+    state = t.next;
+  }
+
+  if (track_position)
+  {
+    token_position = {static_cast<token::Position::value_type>(m_line), static_cast<token::Position::value_type>(1 + (end - line_start))};
+  }
+  m_token_list.emplace_back(token::token_type::eol, std::string_view{end, 0}, track_position ? token_position : token::Position{});
+  pad_symbol_ids();
+  m_reservation.record(line.size(), m_token_list.size() - first_token);
+
+  return true;
+}
+
+dfa_generator::token_list_t const& dfa_generator::get_token_list() const& noexcept
+{
+  return m_token_list;
+}
+
+dfa_generator::token_list_t dfa_generator::get_token_list() && noexcept
+{
+  m_token_list_taken = true;
+  return std::move(m_token_list);
+}
+
+bool dfa_generator::token_list_taken() const noexcept
+{
+  return m_token_list_taken;
+}
+
+std::vector<number_value> const& dfa_generator::get_numbers() const& noexcept
+{
+  return m_numbers;
+}
+
+std::vector<number_value> dfa_generator::get_numbers() && noexcept
+{
+  return std::move(m_numbers);
+}
+
+symbol_table const& dfa_generator::get_symbols() const noexcept
+{
+  return m_symbols;
+}
+
+std::vector<symbol_table::id_type> const& dfa_generator::get_symbol_ids() const& noexcept
+{
+  return m_symbol_ids;
+}
+
+std::vector<symbol_table::id_type> dfa_generator::get_symbol_ids() && noexcept
+{
+  return std::move(m_symbol_ids);
+}
+
+void dfa_generator::pad_symbol_ids()
+{
+  if (m_settings.intern_symbols)
+  {
+    m_symbol_ids.resize(m_token_list.size(), symbol_table::npos);
+  }
+}
+
+token::Position dfa_generator::resolve_position(token const& t) const noexcept
+{
+  if (m_settings.lazy_position && !(m_settings.decode_strings && t.get_type() == token::token_type::string_with_escapes))
+  {
+    return m_line_index.resolve(t.get_value().data());
+  }
+  return t.get_position();
+}
+}  // namespace lexertk
+
+#endif  //LEXERTK_DFA_GENERATOR_IPP
@@ -0,0 +1,31 @@
+//
+// Created by allspark on 17/10/2026.
+//
+
+#ifndef LEXERTK_ESCAPES_HPP
+#define LEXERTK_ESCAPES_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace lexertk
+{
+namespace details
+{
+// Decodes the escape sequences in the text of a string literal into out and
+// returns the decoded length. out must hold text.size() bytes and must not
+// overlap text. Recognised are \n, \r, \t, \\, \', \", \xHH and \uXXXX, the
+// latter written as UTF-8 with surrogate pairs combined. Any other escape,
+// malformed hex digits, a lone surrogate and a trailing backslash are kept
+// as written. Spans without a backslash are copied by the SIMD kernels.
+inline std::size_t decode_escapes(std::string_view text, char* out) noexcept;
+
+// decode_escapes into a new string.
+inline std::string cleanup_escapes(std::string_view s);
+}  // namespace details
+}  // namespace lexertk
+
+#include "escapes.ipp"
+
+#endif  //LEXERTK_ESCAPES_HPP
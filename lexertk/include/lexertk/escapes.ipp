@@ -0,0 +1,163 @@
+//
+// Created by allspark on 17/10/2026.
+//
+
+#ifndef LEXERTK_ESCAPES_IPP
+#define LEXERTK_ESCAPES_IPP
+
+#include "simd.hpp"
+
+#include <cstdint>
+#include <utility>
+
+namespace lexertk
+{
+namespace details
+{
+namespace escapes
+{
+// Value of count hex digits at it, or -1 if one of them is not a hex digit.
+inline std::int32_t hex_value(const char* it, int count) noexcept
+{
+  std::int32_t value = 0;
+  for (int i = 0; i < count; ++i)
+  {
+    char c = it[i];
+    std::int32_t digit = (c >= '0' && c <= '9') ? c - '0' : (c >= 'a' && c <= 'f') ? c - 'a' + 10 : (c >= 'A' && c <= 'F') ? c - 'A' + 10 : -1;
+    if (digit < 0)
+    {
+      return -1;
+    }
+    value = value * 16 + digit;
+  }
+  return value;
+}
+
+inline char* write_utf8(char* out, std::uint32_t cp) noexcept
+{
+  if (cp < 0x80)
+  {
+    *out++ = static_cast<char>(cp);
+  }
+  else if (cp < 0x800)
+  {
+    *out++ = static_cast<char>(0xC0 | (cp >> 6));
+    *out++ = static_cast<char>(0x80 | (cp & 0x3F));
+  }
+  else if (cp < 0x10000)
+  {
+    *out++ = static_cast<char>(0xE0 | (cp >> 12));
+    *out++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+    *out++ = static_cast<char>(0x80 | (cp & 0x3F));
+  }
+  else
+  {
+    *out++ = static_cast<char>(0xF0 | (cp >> 18));
+    *out++ = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+    *out++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+    *out++ = static_cast<char>(0x80 | (cp & 0x3F));
+  }
+  return out;
+}
+
+// Code point of the \uXXXX at it, a surrogate pair taking up two of them,
+// together with the number of input bytes. 0 bytes if it is malformed.
+inline std::pair<std::uint32_t, std::size_t> unicode_escape(const char* it, const char* end) noexcept
+{
+  auto high = (end - it >= 6) ? hex_value(it + 2, 4) : -1;
+  if (high < 0xD800 || high > 0xDFFF)
+  {
+    return {static_cast<std::uint32_t>(high), high < 0 ? 0 : 6};
+  }
+
+  auto low = (high <= 0xDBFF && end - it >= 12 && it[6] == '\\' && it[7] == 'u') ? hex_value(it + 8, 4) : -1;
+  if (low < 0xDC00 || low > 0xDFFF)
+  {
+    return {0, 0};
+  }
+  return {0x10000 + ((static_cast<std::uint32_t>(high) - 0xD800) << 10) + (static_cast<std::uint32_t>(low) - 0xDC00), 12};
+}
+
+// Decodes the escape starting with the backslash at it, returns the input
+// bytes taken. Malformed escapes only take the backslash and the byte after it.
+inline std::size_t decode_escape(const char* it, const char* end, char*& out) noexcept
+{
+  if (end - it < 2)
+  {
+    *out++ = '\\';
+    return 1;
+  }
+
+  switch (it[1])
+  {
+    case 'n':
+      *out++ = '\n';
+      return 2;
+    case 'r':
+      *out++ = '\r';
+      return 2;
+    case 't':
+      *out++ = '\t';
+      return 2;
+    case '\\':
+    case '\'':
+    case '"':
+      *out++ = it[1];
+      return 2;
+    case 'x':
+      if (auto value = (end - it >= 4) ? hex_value(it + 2, 2) : -1; value >= 0)
+      {
+        *out++ = static_cast<char>(value);
+        return 4;
+      }
+      break;
+    case 'u':
+      if (auto [cp, length] = unicode_escape(it, end); length != 0)
+      {
+        out = write_utf8(out, cp);
+        return length;
+      }
+      break;
+  }
+
+  *out++ = '\\';
+  *out++ = it[1];
+  return 2;
+}
+}  // namespace escapes
+
+std::size_t decode_escapes(std::string_view text, char* out) noexcept
+{
+  const char* it = text.data();
+  const char* const end = it + text.size();
+  char* o = out;
+
+  while (it != end)
+  {
+    // escapes often follow each other directly
+    if (*it != '\\')
+    {
+      auto plain = simd::copy_unescaped(it, end, o);
+      it += plain;
+      o += plain;
+      if (it == end)
+      {
+        break;
+      }
+    }
+    it += escapes::decode_escape(it, end, o);
+  }
+
+  return static_cast<std::size_t>(o - out);
+}
+
+std::string cleanup_escapes(std::string_view s)
+{
+  std::string ret(s.size(), '\0');
+  ret.resize(decode_escapes(s, ret.data()));
+  return ret;
+}
+}  // namespace details
+}  // namespace lexertk
+
+#endif  //LEXERTK_ESCAPES_IPP
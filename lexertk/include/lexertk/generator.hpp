@@ -6,13 +6,78 @@
 #define LEXERTK_GENERATOR_HPP
 
 #include "token.hpp"
+#include "compact_token.hpp"
 #include "detail.hpp"
+#include "escapes.hpp"
+#include "keyword_table.hpp"
+#include "line_index.hpp"
+#include "number_value.hpp"
+#include "operator_table.hpp"
+#include "padded_input.hpp"
+#include "reservation_policy.hpp"
+#include "simd.hpp"
+#include "small_token_list.hpp"
+#include "soa_token_list.hpp"
+#include "string_arena.hpp"
+#include "symbol_table.hpp"
+#include "token_list.hpp"
 
+#include <concepts>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace lexertk
 {
-class generator
+struct generator_settings
+{
+  bool hash_as_comment{true};
+  std::size_t lineOffset{0};
+  // tokens are emitted without a position, see resolve_position
+  bool lazy_position{false};
+  // symbols spelling one of these are emitted with the keyword's type
+  keyword_set keywords{default_keywords};
+  // number tokens are converted while lexing, see get_numbers, and are
+  // emitted as err_number if they do not fit their type or lose digits
+  bool parse_numbers{false};
+  // symbol tokens are interned, see get_symbols and get_symbol_ids
+  bool intern_symbols{false};
+  symbol_case symbol_lookup{symbol_case::sensitive};
+  // string_with_escapes tokens get their decoded text, see
+  // details::decode_escapes. A token_list keeps it in its own arena, other
+  // lists of token objects in one of the generator that is reused by reset().
+  // The values of lists without token objects point into the input.
+  bool decode_strings{false};
+  // most tokens room is reserved for ahead of lexing a line, see
+  // reservation_policy
+  std::size_t reserve_limit{reservation_policy::default_limit};
+};
+
+namespace details
+{
+template <typename Token>
+struct stored_position
+{
+  using type = no_position;
+};
+
+template <typename Token>
+  requires requires { typename Token::Position; }
+struct stored_position<Token>
+{
+  using type = typename Token::Position;
+};
+}  // namespace details
+
+// TokenList receives the tokens through
+// emplace_back(token_type, iterator begin, iterator end, Position), Position
+// being the policy of its tokens, see position.hpp, or no_position, and is
+// sized through reserve(), capacity() and clear().
+// A list of tokens without a position, such as compact_token_list, always
+// gets lazy positions and is told about every input through add_source().
+// Lines are only counted for line/column positions.
+template <typename TokenList = token_list>
+class basic_generator
 {
   using iterator = std::string_view::const_iterator;
   struct Range
@@ -26,44 +91,126 @@ class generator
   };
 
 public:
-  using token_list_t = std::vector<token>;
+  using token_list_t = TokenList;
   using token_list_itr_t = typename token_list_t::const_iterator;
+  using token_t = typename token_list_t::value_type;
+  using Settings = generator_settings;
 
-  struct Settings
-  {
-    bool hash_as_comment{true};
-    std::size_t lineOffset{0};
+  static constexpr bool stores_positions = requires(token_t const& t) { t.get_position(); };
+  using stored_position_t = typename details::stored_position<token_t>::type;
+  // lists without positions resolve to 32 bit line/column
+  using position_t = std::conditional_t<stores_positions, stored_position_t, position32>;
+  // lists that turn tokens over a length limit into error tokens
+  static constexpr bool limits_token_length = requires { token_list_t::max_token_length; };
+  static constexpr bool decodes_strings = requires(token_list_t& list, token_t t) {
+    { list.back() } -> std::same_as<token_t&>;
+    t.set_value(std::string_view{});
   };
 
-  generator() = default;
-  inline explicit generator(Settings settings);
-  generator(generator const&) = delete;
-  generator(generator&&) = delete;
-  generator& operator=(generator const&) = delete;
-  generator& operator=(generator&&) = delete;
-  ~generator() = default;
+  basic_generator()
+    : basic_generator(Settings{})
+  {
+  }
+  inline explicit basic_generator(Settings settings);
+  // The token list is constructed with allocator, for example the
+  // std::pmr::memory_resource of a per-request arena.
+  template <typename Allocator>
+    requires std::constructible_from<TokenList, Allocator const&>
+  inline basic_generator(Settings settings, Allocator const& allocator);
+  basic_generator(basic_generator const&) = delete;
+  basic_generator(basic_generator&&) = delete;
+  basic_generator& operator=(basic_generator const&) = delete;
+  basic_generator& operator=(basic_generator&&) = delete;
+  ~basic_generator() = default;
 
   inline bool process(std::string_view line);
+  // Same as process(line), reading ahead into the input's padding instead of
+  // checking for its end in the scanner loops.
+  inline bool process(padded_input line);
+  // Drops everything lexed so far, keeping the memory for the next inputs.
+  // Lines are counted from lineOffset again.
+  inline void reset();
+  // Same as reset(), lexing into the memory of buffer, a list taken from a
+  // generator earlier, from now on.
+  inline void reset(token_list_t&& buffer);
 
   inline token_list_t const& get_token_list() const & noexcept;
   inline token_list_t get_token_list() && noexcept;
+  // Whether the token list was moved out by get_token_list() && since the
+  // last reset.
+  inline bool token_list_taken() const noexcept;
+  // Values of the number tokens in the token list, in token order.
+  inline std::vector<number_value> const& get_numbers() const & noexcept;
+  inline std::vector<number_value> get_numbers() && noexcept;
+  // With intern_symbols, the symbol id of every token in the token list,
+  // symbol_table::npos for tokens that are not symbols.
+  inline symbol_table const& get_symbols() const noexcept;
+  inline std::vector<symbol_table::id_type> const& get_symbol_ids() const & noexcept;
+  inline std::vector<symbol_table::id_type> get_symbol_ids() && noexcept;
+
+  // Position of a token produced by this generator. With lazy_position line
+  // and column are looked up from the token's location in the input, which
+  // must still be alive.
+  inline position_t resolve_position(token_t const& t) const noexcept;
 
 private:
+  template <typename... ListArgs>
+  inline basic_generator(std::in_place_t, Settings settings, ListArgs const&... list_args);
+
+  // Padded: the range is followed by padded_input::padding zero bytes
+  template <bool Padded>
+  inline bool process_line(std::string_view line);
+  template <bool Padded>
   inline Range skip_whitespace(Range) noexcept;
-  inline Range skip_comments(Range) noexcept;
-  inline Range scan_token(Range) noexcept;
+  template <bool Padded>
+  inline Range skip_comment(Range) noexcept;
+  template <bool Padded>
   inline Range scan_operator(Range) noexcept;
+  template <bool Padded>
   inline Range scan_symbol(Range) noexcept;
+  template <bool Padded>
   inline Range scan_number(Range) noexcept;
   inline Range scan_string(Range) noexcept;
+  inline Range scan_invalid(Range) noexcept;
+
+  inline position_t position_of(iterator) const noexcept;
+  inline void advance_lines(iterator, details::simd::text_run const&) noexcept;
+  inline void emit(token::token_type, iterator begin, iterator end);
+  inline void emit_number(iterator begin, iterator end);
+  inline void intern_symbol(iterator begin, iterator end);
+  inline void decode_string(iterator begin, iterator end);
+  inline void pad_symbol_ids();
+  // an empty list with the allocator of m_token_list
+  inline token_list_t empty_list() const;
 
 private:
   token_list_t m_token_list;
-  token::Position m_currentPosition{0, 0};
+  bool m_token_list_taken{false};
+  std::size_t m_line{0};
+  iterator m_line_start{};
+  // offset_position only
+  iterator m_input_begin{};
+  std::size_t m_input_offset{0};
+  std::size_t m_next_input_offset{0};
+  line_index m_line_index;
+  std::vector<number_value> m_numbers;
+  symbol_table m_symbols;
+  std::vector<symbol_table::id_type> m_symbol_ids;
+  string_arena m_strings;
+  reservation_policy m_reservation;
   token m_eof_token{token::token_type::eof, token::Position{}};
 
   Settings m_settings;
 };
+
+using generator = basic_generator<>;
+// 8 bytes per token, values and positions are resolved on demand
+using compact_generator = basic_generator<compact_token_list>;
+// one array per token field, for passes over a single field
+using soa_generator = basic_generator<soa_token_list>;
+// no allocation for expressions of up to 64 tokens
+using small_generator = basic_generator<small_token_list>;
+
 inline void dump(generator::token_list_t const& list);
 }  // namespace lexertk
 
@@ -7,275 +7,597 @@
 
 #include <fmt/format.h>
 
-#include <tuple>
+#include <array>
+#include <cstdint>
+#include <memory>
 
 namespace lexertk
 {
-generator::Range::operator bool() const noexcept
+namespace details
+{
+// What a token starting with a given byte is, as far as the first byte tells.
+enum class token_start : std::uint8_t
+{
+  invalid,
+  whitespace,
+  slash_or_hash,  // a comment or an operator
+  operator_char,
+  letter,
+  digit,
+  string_delimiter
+};
+
+inline constexpr std::array<token_start, 256> token_start_table = []()
+{
+  std::array<token_start, 256> table{};
+  for (std::size_t i = 0; i < table.size(); ++i)
+  {
+    switch (char_class_table[i] & char_class::leading)
+    {
+      case char_class::whitespace:
+        table[i] = token_start::whitespace;
+        break;
+      case char_class::operator_char:
+        table[i] = (i == '/' || i == '#') ? token_start::slash_or_hash : token_start::operator_char;
+        break;
+      case char_class::letter:
+        table[i] = token_start::letter;
+        break;
+      case char_class::digit:
+        table[i] = token_start::digit;
+        break;
+      case char_class::string_delimiter:
+        table[i] = token_start::string_delimiter;
+        break;
+    }
+  }
+  return table;
+}();
+
+constexpr token_start token_start_of(char c) noexcept
+{
+  return token_start_table[static_cast<unsigned char>(c)];
+}
+}  // namespace details
+
+template <typename TokenList>
+basic_generator<TokenList>::Range::operator bool() const noexcept
 {
   return begin != end;
 }
 
-generator::Range& generator::Range::operator++() noexcept
+template <typename TokenList>
+typename basic_generator<TokenList>::Range& basic_generator<TokenList>::Range::operator++() noexcept
 {
   ++begin;
   return *this;
 }
 
-generator::Range& generator::Range::operator+=(std::size_t off) noexcept
+template <typename TokenList>
+typename basic_generator<TokenList>::Range& basic_generator<TokenList>::Range::operator+=(std::size_t off) noexcept
 {
   begin += off;
   return *this;
 }
 
-generator::generator(Settings settings)
-  : m_settings{settings}
+template <typename TokenList>
+basic_generator<TokenList>::basic_generator(Settings settings)
+  : basic_generator(std::in_place, settings)
+{
+}
+
+template <typename TokenList>
+template <typename Allocator>
+  requires std::constructible_from<TokenList, Allocator const&>
+basic_generator<TokenList>::basic_generator(Settings settings, Allocator const& allocator)
+  : basic_generator(std::in_place, settings, allocator)
+{
+}
+
+template <typename TokenList>
+template <typename... ListArgs>
+basic_generator<TokenList>::basic_generator(std::in_place_t, Settings settings, ListArgs const&... list_args)
+  : m_token_list(list_args...)
+  , m_line{settings.lineOffset}
+  , m_symbols{settings.symbol_lookup}
+  , m_reservation{settings.reserve_limit}
+  , m_settings{settings}
+{
+  if constexpr (!stores_positions)
+  {
+    m_settings.lazy_position = true;
+  }
+  else if constexpr (!has_line_column<position_t>)
+  {
+    m_settings.lazy_position = false;
+  }
+}
+
+template <typename TokenList>
+bool basic_generator<TokenList>::process(std::string_view line)
+{
+  return process_line<false>(line);
+}
+
+template <typename TokenList>
+bool basic_generator<TokenList>::process(padded_input line)
+{
+  return process_line<true>(line.text());
+}
+
+template <typename TokenList>
+void basic_generator<TokenList>::reset()
+{
+  // a list still sized for a rare huge input is given back
+  if (auto capacity = m_reservation.shrink_to(m_token_list.size(), m_token_list.capacity()))
+  {
+    m_token_list = empty_list();
+    m_token_list.reserve(capacity);
+  }
+  m_token_list.clear();
+  m_token_list_taken = false;
+  m_line = m_settings.lineOffset;
+  m_line_start = {};
+  m_input_begin = {};
+  m_input_offset = 0;
+  m_next_input_offset = 0;
+  m_line_index.clear();
+  m_numbers.clear();
+  m_symbols.clear();
+  m_symbol_ids.clear();
+  m_strings.clear();
+}
+
+template <typename TokenList>
+void basic_generator<TokenList>::reset(token_list_t&& buffer)
 {
-  m_currentPosition.line += m_settings.lineOffset;
+  reset();
+  m_token_list = std::move(buffer);
+  m_token_list.clear();
 }
 
-bool generator::process(std::string_view line)
+template <typename TokenList>
+template <bool Padded>
+bool basic_generator<TokenList>::process_line(std::string_view line)
 {
-  m_currentPosition.NextLine();
+  if constexpr (has_line_column<position_t>)
+  {
+    ++m_line;
+    m_line_start = line.begin();
+    if (m_settings.lazy_position)
+    {
+      m_line_index.add(line, m_line);
+    }
+  }
+  else if constexpr (has_offset<position_t>)
+  {
+    // one more for the eol token, as if the inputs were joined by newlines
+    m_input_begin = line.begin();
+    m_input_offset = m_next_input_offset;
+    m_next_input_offset += line.size() + 1;
+  }
+  if constexpr (requires { m_token_list.add_source(line); })
+  {
+    m_token_list.add_source(line);
+  }
+
   Range range = {line.begin(), line.end()};
-  m_token_list.reserve(line.size());
+  const std::size_t first_token = m_token_list.size();
+  // a list with inline storage leaves it on demand only, the estimate would
+  // also move expressions that just fit onto the heap
+  bool reserves = true;
+  if constexpr (requires { token_list_t::inline_capacity; })
+  {
+    reserves = !m_token_list.is_inline();
+  }
+  if (auto capacity = reserves ? m_reservation.reserve_for(line.size(), first_token, m_token_list.capacity()) : 0)
+  {
+    m_token_list.reserve(capacity);
+  }
+  if (m_settings.intern_symbols)
+  {
+    m_symbol_ids.reserve(m_token_list.capacity());
+  }
 
+  // one jump per token on the class of its first byte, whitespace and
+  // comments are skipped in place and go straight back to the dispatch
   while (range)
   {
-    range = scan_token(range);
+    switch (details::token_start_of(*range.begin))
+    {
+      case details::token_start::whitespace:
+        range = skip_whitespace<Padded>(range);
+        continue;
+      case details::token_start::slash_or_hash:
+        if (auto rest = skip_comment<Padded>(range); rest.begin != range.begin)
+        {
+          range = rest;
+          continue;
+        }
+        range = scan_operator<Padded>(range);
+        continue;
+      case details::token_start::operator_char:
+        range = scan_operator<Padded>(range);
+        continue;
+      case details::token_start::letter:
+        range = scan_symbol<Padded>(range);
+        // a symbol over the length limit of the list is an error token
+        if constexpr (!limits_token_length)
+        {
+          continue;
+        }
+        break;
+      case details::token_start::digit:
+        range = scan_number<Padded>(range);
+        break;
+      case details::token_start::string_delimiter:
+        range = scan_string(range);
+        break;
+      case details::token_start::invalid:
+        range = scan_invalid(range);
+        break;
+    }
 
-    if (!m_token_list.empty() && m_token_list.back().is_error())
+    // only the scanners that reach the check can emit an error token
+    if (m_token_list.back().is_error())
     {
+      pad_symbol_ids();
+      m_reservation.record(line.size(), m_token_list.size() - first_token);
       return false;
     }
   }
-  m_token_list.emplace_back(token::token_type::eol, m_currentPosition);
+  emit(token::token_type::eol, line.end(), line.end());
+  pad_symbol_ids();
+  m_reservation.record(line.size(), m_token_list.size() - first_token);
 
   return true;
 }
 
-generator::token_list_t const& generator::get_token_list() const& noexcept
+template <typename TokenList>
+typename basic_generator<TokenList>::token_list_t const& basic_generator<TokenList>::get_token_list() const& noexcept
 {
   return m_token_list;
 }
 
-generator::token_list_t generator::get_token_list() && noexcept
+template <typename TokenList>
+typename basic_generator<TokenList>::token_list_t basic_generator<TokenList>::get_token_list() && noexcept
 {
+  m_token_list_taken = true;
   return std::move(m_token_list);
 }
 
-generator::Range generator::skip_whitespace(Range range) noexcept
+template <typename TokenList>
+bool basic_generator<TokenList>::token_list_taken() const noexcept
 {
-  while (range && details::is_whitespace(*range.begin))
-  {
-    if (*range.begin == '\n')
-    {
-      m_currentPosition.NextLine();
-    }
-    else
-    {
-      m_currentPosition.NextColumn();
-    }
-    ++range;
-  }
-  return range;
+  return m_token_list_taken;
 }
 
-namespace
+template <typename TokenList>
+std::vector<number_value> const& basic_generator<TokenList>::get_numbers() const& noexcept
 {
-enum struct CommentMode
+  return m_numbers;
+}
+
+template <typename TokenList>
+std::vector<number_value> basic_generator<TokenList>::get_numbers() && noexcept
 {
-  NONE,
-  COMMENT_START,
-  STAR
-};
-enum struct CommentIncrement
+  return std::move(m_numbers);
+}
+
+template <typename TokenList>
+symbol_table const& basic_generator<TokenList>::get_symbols() const noexcept
 {
-  NONE = 0,
-  ONE = 1,
-  TWO = 2
-};
-std::tuple<CommentMode, CommentIncrement> comment_start(const char c0, const char c1, bool hash_as_comment) noexcept
+  return m_symbols;
+}
+
+template <typename TokenList>
+std::vector<symbol_table::id_type> const& basic_generator<TokenList>::get_symbol_ids() const& noexcept
+{
+  return m_symbol_ids;
+}
+
+template <typename TokenList>
+std::vector<symbol_table::id_type> basic_generator<TokenList>::get_symbol_ids() && noexcept
+{
+  return std::move(m_symbol_ids);
+}
+
+template <typename TokenList>
+typename basic_generator<TokenList>::position_t basic_generator<TokenList>::resolve_position(token_t const& t) const noexcept
 {
-  if (hash_as_comment && '#' == c0)
+  if constexpr (!stores_positions)
   {
-    return {CommentMode::COMMENT_START, CommentIncrement::ONE};
+    return m_line_index.resolve<position_t>(m_token_list.location_of(t));
   }
-  else if ('/' == c0)
+  else
   {
-    if ('/' == c1)
-    {
-      return {CommentMode::COMMENT_START, CommentIncrement::TWO};
-    }
-    else if ('*' == c1)
+    if constexpr (has_line_column<position_t>)
     {
-      return {CommentMode::STAR, CommentIncrement::TWO};
+      // decoded strings point into the arena and carry their position
+      if (m_settings.lazy_position && !(m_settings.decode_strings && t.get_type() == token::token_type::string_with_escapes))
+      {
+        return m_line_index.resolve<position_t>(t.get_value().data());
+      }
     }
+    return t.get_position();
   }
-  return {CommentMode::NONE, CommentIncrement::NONE};
 }
 
-bool comment_end(const char c0, const char c1, CommentMode mode) noexcept
+template <typename TokenList>
+typename basic_generator<TokenList>::position_t basic_generator<TokenList>::position_of(iterator it) const noexcept
 {
-  return ((mode == CommentMode::COMMENT_START) && ('\n' == c0)) || ((mode == CommentMode::STAR) && ('*' == c0) && ('/' == c1));
+  if constexpr (has_line_column<position_t>)
+  {
+    using value_type = typename position_t::value_type;
+    return {static_cast<value_type>(m_line), static_cast<value_type>(1 + std::distance(m_line_start, it))};
+  }
+  else if constexpr (has_offset<position_t>)
+  {
+    return {m_input_offset + static_cast<std::size_t>(std::distance(m_input_begin, it))};
+  }
+  else
+  {
+    return {};
+  }
 }
-}  // namespace
 
-generator::Range generator::skip_comments(Range range) noexcept
+template <typename TokenList>
+void basic_generator<TokenList>::advance_lines(iterator begin, details::simd::text_run const& run) noexcept
 {
-  //The following comment styles are supported:
-  // 1. // .... \n
-  // 2. #  .... \n
-  // 3. /* .... */
+  if constexpr (has_line_column<position_t>)
+  {
+    if (run.newlines != 0)
+    {
+      m_line += run.newlines;
+      m_line_start = begin + run.line_start;
+    }
+  }
+}
 
-  if (!range || range.begin + 1 == range.end)
-    return range;
+template <typename TokenList>
+void basic_generator<TokenList>::emit(token::token_type type, iterator begin, iterator end)
+{
+  if constexpr (stores_positions)
+  {
+    m_token_list.emplace_back(type, begin, end, m_settings.lazy_position ? position_t{} : position_of(begin));
+  }
+  else
+  {
+    m_token_list.emplace_back(type, begin, end, stored_position_t{});
+  }
+}
 
-  auto [mode, increment] = comment_start(*range.begin, *(range.begin + 1), m_settings.hash_as_comment);
-  if (mode == CommentMode::NONE)
+template <typename TokenList>
+void basic_generator<TokenList>::emit_number(iterator begin, iterator end)
+{
+  if (m_settings.parse_numbers)
   {
-    return range;
+    number_value number{m_token_list.size(), {}};
+    if (!details::convert_number({begin, end}, number.value))
+    {
+      emit(token::token_type::err_number, begin, end);
+      return;
+    }
+    m_numbers.push_back(number);
   }
+  emit(token::token_type::number, begin, end);
+}
 
-  range.begin += static_cast<std::size_t>(increment);
+template <typename TokenList>
+void basic_generator<TokenList>::intern_symbol(iterator begin, iterator end)
+{
+  // the tokens since the previous symbol are not symbols
+  m_symbol_ids.resize(m_token_list.size(), symbol_table::npos);
+  m_symbol_ids.push_back(m_symbols.intern({begin, end}));
+}
 
-  while (range && !comment_end(*range.begin, *(range.begin + 1), mode))
+template <typename TokenList>
+void basic_generator<TokenList>::decode_string(iterator begin, iterator end)
+{
+  if constexpr (decodes_strings)
   {
-    if (*range.begin == '\n')
+    std::string_view text{begin, end};
+    std::string_view value;
+    // lists with an arena of their own keep the value, it then outlives the
+    // generator and its reset()
+    if constexpr (requires { m_token_list.store_value(text); })
     {
-      m_currentPosition.NextLine();
+      value = m_token_list.store_value(text.size(), [text](char* out) { return details::decode_escapes(text, out); });
     }
     else
     {
-      m_currentPosition.NextColumn();
+      char* out = m_strings.allocate(text.size());
+      auto size = details::decode_escapes(text, out);
+      m_strings.release_tail(text.size() - size);
+      value = {out, size};
     }
-    ++range;
+    // stored with its position even with lazy_position, the value is no longer in the input
+    m_token_list.back() = token_t{token::token_type::string_with_escapes, value, position_of(begin)};
   }
-
-  if (range)
-  {
-    range += static_cast<std::size_t>(mode);
-    range = skip_whitespace(range);
-    range = skip_comments(range);
-  }
-
-  return range;
 }
 
-generator::Range generator::scan_token(Range range) noexcept
+template <typename TokenList>
+typename basic_generator<TokenList>::token_list_t basic_generator<TokenList>::empty_list() const
 {
-  range = skip_whitespace(range);
-  range = skip_comments(range);
-
-  if (!range)
+  if constexpr (requires { token_list_t(m_token_list.get_allocator()); })
   {
-    return range;
+    return token_list_t(m_token_list.get_allocator());
   }
-  else if (details::is_operator_char(*range.begin))
+  else
   {
-    return scan_operator(range);
+    return token_list_t{};
   }
-  else if (details::is_letter(*range.begin))
+}
+
+template <typename TokenList>
+void basic_generator<TokenList>::pad_symbol_ids()
+{
+  if (m_settings.intern_symbols)
   {
-    return scan_symbol(range);
+    m_symbol_ids.resize(m_token_list.size(), symbol_table::npos);
   }
-  else if (details::is_digit(*range.begin))
+}
+
+template <typename TokenList>
+template <bool Padded>
+typename basic_generator<TokenList>::Range basic_generator<TokenList>::skip_whitespace(Range range) noexcept
+{
+  // only dispatched to on a whitespace byte
+  auto run = details::simd::scan_whitespace<Padded>(std::to_address(range.begin), std::to_address(range.end));
+
+  advance_lines(range.begin, run);
+
+  return range += run.length;
+}
+
+template <typename TokenList>
+template <bool Padded>
+typename basic_generator<TokenList>::Range basic_generator<TokenList>::skip_comment(Range range) noexcept
+{
+  //The following comment styles are supported:
+  // 1. // .... \n
+  // 2. #  .... \n
+  // 3. /* .... */
+
+  // with padding the byte after the last one reads as zero, which starts no comment
+  if (!Padded && range.begin + 1 == range.end)
   {
-    return scan_number(range);
+    return range;
   }
-  else if (details::is_string_delimiter(*range.begin))
+
+  const char c0 = *range.begin;
+  const char c1 = *(range.begin + 1);
+  auto body = std::to_address(range.begin);
+  auto end = std::to_address(range.end);
+
+  // a '#' ending the input is lexed as an operator either way
+  if ((m_settings.hash_as_comment && '#' == c0 && (!Padded || range.begin + 1 != range.end)) || ('/' == c0 && '/' == c1))
   {
-    return scan_string(range);
+    body += ('#' == c0) ? 1 : 2;
+    // the terminating '\n' is left to skip_whitespace, which accounts for the new line
+    range += static_cast<std::size_t>(body - std::to_address(range.begin)) + details::simd::find_newline(body, end);
   }
-  else
+  else if ('/' == c0 && '*' == c1)
   {
-    auto end = range.begin + 2;
-    m_token_list.emplace_back(token::token_type::error, range.begin, end, m_currentPosition.IncrementColumn(range.begin, end));
-    ++range;
+    range += 2;
+    auto run = details::simd::scan_block_comment(body + 2, end);
+    advance_lines(range.begin, run);
+    range += run.length;
   }
+
   return range;
 }
 
-generator::Range generator::scan_operator(Range range) noexcept
+template <typename TokenList>
+typename basic_generator<TokenList>::Range basic_generator<TokenList>::scan_invalid(Range range) noexcept
+{
+  // the offending character and the one after it, if any
+  emit(token::token_type::error, range.begin, range.begin + std::min<std::ptrdiff_t>(2, std::distance(range.begin, range.end)));
+  return ++range;
+}
+
+template <typename TokenList>
+template <bool Padded>
+typename basic_generator<TokenList>::Range basic_generator<TokenList>::scan_operator(Range range) noexcept
 {
-  if (range.begin + 1 != range.end)
+  // longest match first, the table is keyed on the packed operator characters
+  // padding zeros never match an operator key, so the whole key width can be read
+  auto remaining = Padded ? details::operator_table.max_length : static_cast<std::size_t>(std::distance(range.begin, range.end));
+  for (auto length = std::min(details::operator_table.max_length, remaining); length > 1; --length)
   {
-    token::token_type ttype = [](const unsigned char c0, const unsigned char c1)
+    auto type = details::operator_table.find(details::operator_key({std::to_address(range.begin), length}));
+    if (token::token_type::none != type)
     {
-      if (c0 == '<' && c1 == '=')
-        return token::token_type::lte;
-      if (c0 == '>' && c1 == '=')
-        return token::token_type::gte;
-      if (c0 == '<' && c1 == '>')
-        return token::token_type::ne;
-      if (c0 == '!' && c1 == '=')
-        return token::token_type::ne;
-      if (c0 == '=' && c1 == '=')
-        return token::token_type::eq;
-      if (c0 == ':' && c1 == '=')
-        return token::token_type::rebind;
-      if (c0 == '<' && c1 == '<')
-        return token::token_type::shl;
-      if (c0 == '>' && c1 == '>')
-        return token::token_type::shr;
-      if (c0 == ':' && c1 == ':')
-        return token::token_type::scope;
-      if (c0 == '&' && c1 == '&')
-        return token::token_type::logical_and;
-      if (c0 == '|' && c1 == '|')
-        return token::token_type::logical_or;
-
-      return token::token_type::none;
-    }(*range.begin, *(range.begin + 1));
-
-    if (token::token_type::none != ttype)
-    {
-      auto end = range.begin + 2;
-      m_token_list.emplace_back(ttype, range.begin, end, m_currentPosition.IncrementColumn(range.begin, end));
-      range += 2;
-      return range;
+      emit(type, range.begin, range.begin + length);
+      return range += length;
     }
   }
 
-  auto end = range.begin + 1;
-  auto pos = m_currentPosition.IncrementColumn(range.begin, end);
-
-  m_token_list.emplace_back(static_cast<token::token_type>(*range.begin), range.begin, end, pos);
+  emit(static_cast<token::token_type>(*range.begin), range.begin, range.begin + 1);
 
   return ++range;
 }
 
-generator::Range generator::scan_symbol(Range range) noexcept
+template <typename TokenList>
+template <bool Padded>
+typename basic_generator<TokenList>::Range basic_generator<TokenList>::scan_symbol(Range range) noexcept
 {
   auto begin = range.begin;
-  while (range && (details::is_letter_or_digit(*range.begin) || ((*range.begin) == '_')))
-  {
-    ++range;
-  }
+  range += details::simd::scan_symbol<Padded>(std::to_address(range.begin), std::to_address(range.end));
 
-  bool isBoolean = [](iterator begin, iterator end)
+  auto type = m_settings.keywords.classify({begin, range.begin});
+  if (type == token::token_type::symbol && m_settings.intern_symbols)
   {
-    constexpr static std::string_view FALSEValue{"false"};
-    if (!std::equal(begin, end, FALSEValue.begin(), FALSEValue.end()))
-    {
-      constexpr static std::string_view TRUEValue{"true"};
-      return std::equal(begin, end, TRUEValue.begin(), TRUEValue.end());
-    }
-    return true;
-  }(begin, range.begin);
-  if (isBoolean)
-  {
-    m_token_list.emplace_back(token::token_type::boolean, begin, range.begin, m_currentPosition.IncrementColumn(begin, range.begin));
-  }
-  else
-  {
-    m_token_list.emplace_back(token::token_type::symbol, begin, range.begin, m_currentPosition.IncrementColumn(begin, range.begin));
+    intern_symbol(begin, range.begin);
   }
+  emit(type, begin, range.begin);
 
   return range;
 }
 
-generator::Range generator::scan_number(Range range) noexcept
+namespace details
+{
+namespace number
+{
+enum : std::uint8_t
+{
+  // what has been seen so far, together these make up the scanner state
+  dot = 0x01,
+  exponent = 0x02,
+  exponent_sign = 0x04,
+  exponent_digit = 0x08,
+  // outcomes of a transition other than a next state
+  stop = 0x10,       // the byte is not part of the number
+  malformed = 0x20,  // the number is invalid up to the byte
+};
+
+// Classes of the byte ending a digit run.
+enum input : std::uint8_t
+{
+  other,
+  dot_char,
+  exponent_char,
+  sign_char,
+  input_count
+};
+
+constexpr input input_of(char c) noexcept
+{
+  switch (c)
+  {
+    case '.':
+      return dot_char;
+    case 'e':
+    case 'E':
+      return exponent_char;
+    case '+':
+    case '-':
+      return sign_char;
+    default:
+      return other;
+  }
+}
+
+inline constexpr auto transitions = []
+{
+  std::array<std::array<std::uint8_t, input_count>, 16> table{};
+  for (std::uint8_t state = 0; state < table.size(); ++state)
+  {
+    table[state][other] = stop;
+    table[state][dot_char] = (state & dot) ? malformed : state | dot;
+    // an exponent must be followed by a sign or digit, which is checked on the byte after it
+    table[state][exponent_char] = state | exponent;
+    // a sign only belongs to the number right after the exponent
+    table[state][sign_char] = (!(state & exponent) || (state & exponent_digit)) ? stop : (state & exponent_sign) ? malformed : state | exponent_sign;
+  }
+  return table;
+}();
+}  // namespace number
+}  // namespace details
+
+template <typename TokenList>
+template <bool Padded>
+typename basic_generator<TokenList>::Range basic_generator<TokenList>::scan_number(Range range) noexcept
 {
   /*
        Attempt to match a valid numeric value in one of the following formats:
@@ -295,130 +617,82 @@ generator::Range generator::scan_number(Range range) noexcept
        14. .1234e-3
     */
   auto begin = range.begin;
-  bool dot_found = false;
-  bool e_found = false;
-  bool post_e_sign_found = false;
-  bool post_e_digit_found = false;
+  auto it = std::to_address(range.begin);
+  auto end = std::to_address(range.end);
+  std::uint8_t state = 0;
 
-  while (range)
+  // digit runs are skipped in bulk, only the bytes between them go through the state table
+  for (;;)
   {
-    if ('.' == *range.begin)
-    {
-      if (dot_found)
-      {
-        m_token_list.emplace_back(token::token_type::err_number, begin, range.begin, m_currentPosition.IncrementColumn(begin, range.begin));
-        return range;
-      }
+    auto digits = details::simd::scan_digits<Padded>(it, end);
+    it += digits;
+    state |= (digits != 0 && (state & details::number::exponent)) ? details::number::exponent_digit : 0;
 
-      dot_found = true;
-      ++range;
-      continue;
-    }
-    else if (details::imatch('e', (*range.begin)))
+    // past the end of padded input the zero byte is classified as other
+    if (!Padded && it == end)
     {
-      if (range.begin + 1 == range.end)
-      {
-        m_token_list.emplace_back(token::token_type::err_number, begin, range.begin, m_currentPosition.IncrementColumn(begin, range.begin));
-        return range;
-      }
-      else if (auto c = *(range.begin + 1); ('+' != c) && ('-' != c) && !details::is_digit(c))
-      {
-        m_token_list.emplace_back(token::token_type::err_number, begin, range.begin, m_currentPosition.IncrementColumn(begin, range.begin));
-        return range;
-      }
-
-      e_found = true;
-      ++range;
-
-      continue;
+      break;
     }
-    else if (e_found && details::is_sign(*range.begin) && !post_e_digit_found)
-    {
-      if (post_e_sign_found)
-      {
-        m_token_list.emplace_back(token::token_type::err_number, begin, range.begin, m_currentPosition.IncrementColumn(begin, range.begin));
-        return range;
-      }
 
-      post_e_sign_found = true;
-      ++range;
-
-      continue;
-    }
-    else if (e_found && details::is_digit(*range.begin))
+    auto input = details::number::input_of(*it);
+    auto next = details::number::transitions[state][input];
+    if (input == details::number::exponent_char && ((!Padded && it + 1 == end) || !(details::is_sign(it[1]) || details::is_digit(it[1]))))
     {
-      post_e_digit_found = true;
-      ++range;
+      next = details::number::malformed;
+    }
 
-      continue;
+    if (next & details::number::malformed)
+    {
+      range += static_cast<std::size_t>(it - std::to_address(range.begin));
+      emit(token::token_type::err_number, begin, range.begin);
+      return range;
     }
-    else if (('.' != (*range.begin)) && !details::is_digit(*range.begin))
+    else if (next & details::number::stop)
+    {
       break;
-    else
-      ++range;
+    }
+
+    state = next;
+    ++it;
   }
 
-  m_token_list.emplace_back(token::token_type::number, begin, range.begin, m_currentPosition.IncrementColumn(begin, range.begin));
+  range += static_cast<std::size_t>(it - std::to_address(range.begin));
+  emit_number(begin, range.begin);
   return range;
 }
 
-generator::Range generator::scan_string(Range range) noexcept
+template <typename TokenList>
+typename basic_generator<TokenList>::Range basic_generator<TokenList>::scan_string(Range range) noexcept
 {
   auto begin = range.begin + 1;
-  m_currentPosition.NextColumn();
   if (std::distance(range.begin, range.end) < 2)
   {
-    m_token_list.emplace_back(token::token_type::err_string, range.begin, range.end, m_currentPosition.IncrementColumn(range.begin, range.end));
+    emit(token::token_type::err_string, range.begin, range.end);
     return range;
   }
 
   ++range;
 
-  bool escaped_found = false;
-  bool escaped = false;
-
-  while (range)
-  {
-    if (!escaped && ('\\' == *range.begin))
-    {
-      escaped_found = true;
-      escaped = true;
-      ++range;
-      continue;
-    }
-    else if (!escaped)
-    {
-      if (details::is_string_delimiter(*range.begin))
-        break;
-    }
-    else if (escaped)
-      escaped = false;
-
-    ++range;
-  }
+  auto run = details::simd::scan_string(std::to_address(range.begin), std::to_address(range.end));
+  range += run.length;
 
   if (!range)
   {
-    m_token_list.emplace_back(token::token_type::err_string, begin, range.begin, m_currentPosition.IncrementColumn(begin, range.begin));
+    emit(token::token_type::err_string, begin, range.begin);
     return range;
   }
 
-  //      if (!escaped_found)
-  //      t.set_string(begin, m_s_itr, m_base_itr);
-  //      else
-  //      {
-  //        std::string parsed_string(begin, s_itr_);
-  //        details::cleanup_escapes(parsed_string);
-  //        t.set_string(parsed_string, std::distance(base_itr_, begin));
-  //      }
+  auto string_type = run.escaped ? token::token_type::string_with_escapes : token::token_type::string;
 
-  auto string_type = escaped_found ? token::token_type::string_with_escapes : token::token_type::string;
-
-  m_token_list.emplace_back(string_type, begin, range.begin, m_currentPosition.IncrementColumn(begin, range.begin));
-  ++range;
-  m_currentPosition.NextColumn();
+  emit(string_type, begin, range.begin);
+  if (run.escaped && m_settings.decode_strings)
+  {
+    decode_string(begin, range.begin);
+  }
+  // the literal may span lines, its own position is taken before they are counted
+  advance_lines(begin, run);
 
-  return range;
+  return ++range;
 }
 
 void dump(generator::token_list_t const& list)
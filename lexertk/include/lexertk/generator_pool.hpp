@@ -0,0 +1,108 @@
+//
+// Created by allspark on 17/10/2026.
+//
+
+#ifndef LEXERTK_GENERATOR_POOL_HPP
+#define LEXERTK_GENERATOR_POOL_HPP
+
+#include "generator.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace lexertk
+{
+// Keeps idle generators with warm buffers for reuse instead of constructing
+// one per input. A pool is not synchronized, it is meant to be owned by one
+// thread, see local(). Leases must be returned to the pool on the thread that
+// took them and before the pool is destroyed. With decode_strings, lists
+// other than token_list point into their generator for decoded strings, which
+// are only valid until the lease ends.
+template <typename Generator>
+class basic_generator_pool
+{
+public:
+  using generator_t = Generator;
+  using token_list_t = typename Generator::token_list_t;
+  using Settings = generator_settings;
+  class lease;
+
+  static constexpr std::size_t default_max_idle = 16;
+
+  basic_generator_pool()
+    : basic_generator_pool(Settings{})
+  {
+  }
+  inline explicit basic_generator_pool(Settings settings, std::size_t max_idle = default_max_idle);
+  basic_generator_pool(basic_generator_pool const&) = delete;
+  basic_generator_pool(basic_generator_pool&&) = delete;
+  basic_generator_pool& operator=(basic_generator_pool const&) = delete;
+  basic_generator_pool& operator=(basic_generator_pool&&) = delete;
+  ~basic_generator_pool() = default;
+
+  // The pool of the calling thread, for generators with default settings.
+  static inline basic_generator_pool& local();
+
+  // An idle generator, or a new one if there is none. It has not lexed
+  // anything yet and is reset when the lease ends.
+  inline lease acquire();
+  // Hands a list taken out of a leased generator back once the caller is
+  // done with it. Its memory is given to the next generator returned without
+  // a list of its own.
+  inline void recycle(token_list_t&& list);
+
+  // Generators and lists waiting for reuse.
+  inline std::size_t idle() const noexcept;
+  inline std::size_t idle_lists() const noexcept;
+
+private:
+  inline void release(std::unique_ptr<Generator> g) noexcept;
+
+  Settings m_settings;
+  std::size_t m_max_idle;
+  std::vector<std::unique_ptr<Generator>> m_idle;
+  std::vector<token_list_t> m_lists;
+};
+
+// Exclusive use of a pooled generator, returned to the pool on destruction.
+template <typename Generator>
+class basic_generator_pool<Generator>::lease
+{
+public:
+  lease() = default;
+  lease(basic_generator_pool* pool, std::unique_ptr<Generator> g) noexcept
+    : m_pool{pool}
+    , m_generator{std::move(g)}
+  {
+  }
+  lease(lease const&) = delete;
+  lease(lease&&) noexcept = default;
+  lease& operator=(lease const&) = delete;
+  inline lease& operator=(lease&& other) noexcept;
+  inline ~lease();
+
+  Generator& operator*() const noexcept
+  {
+    return *m_generator;
+  }
+  Generator* operator->() const noexcept
+  {
+    return m_generator.get();
+  }
+  Generator* get() const noexcept
+  {
+    return m_generator.get();
+  }
+
+private:
+  basic_generator_pool* m_pool{nullptr};
+  std::unique_ptr<Generator> m_generator;
+};
+
+using generator_pool = basic_generator_pool<generator>;
+}  // namespace lexertk
+
+#include "generator_pool.ipp"
+
+#endif  //LEXERTK_GENERATOR_POOL_HPP
@@ -0,0 +1,113 @@
+//
+// Created by allspark on 17/10/2026.
+//
+
+#ifndef LEXERTK_GENERATOR_POOL_IPP
+#define LEXERTK_GENERATOR_POOL_IPP
+
+#include <utility>
+
+namespace lexertk
+{
+template <typename Generator>
+basic_generator_pool<Generator>::basic_generator_pool(Settings settings, std::size_t max_idle)
+  : m_settings{settings}
+  , m_max_idle{max_idle}
+{
+}
+
+template <typename Generator>
+basic_generator_pool<Generator>& basic_generator_pool<Generator>::local()
+{
+  thread_local basic_generator_pool pool;
+  return pool;
+}
+
+template <typename Generator>
+typename basic_generator_pool<Generator>::lease basic_generator_pool<Generator>::acquire()
+{
+  if (m_idle.empty())
+  {
+    return {this, std::make_unique<Generator>(m_settings)};
+  }
+  auto g = std::move(m_idle.back());
+  m_idle.pop_back();
+  return {this, std::move(g)};
+}
+
+template <typename Generator>
+void basic_generator_pool<Generator>::recycle(token_list_t&& list)
+{
+  if (m_lists.size() < m_max_idle)
+  {
+    list.clear();
+    m_lists.push_back(std::move(list));
+  }
+}
+
+template <typename Generator>
+std::size_t basic_generator_pool<Generator>::idle() const noexcept
+{
+  return m_idle.size();
+}
+
+template <typename Generator>
+std::size_t basic_generator_pool<Generator>::idle_lists() const noexcept
+{
+  return m_lists.size();
+}
+
+template <typename Generator>
+void basic_generator_pool<Generator>::release(std::unique_ptr<Generator> g) noexcept
+{
+  if (m_idle.size() == m_max_idle)
+  {
+    return;
+  }
+
+  // a generator that fails to reset is dropped instead of pooled
+  try
+  {
+    // the list was moved out of it, lex into a recycled one next time
+    if (g->token_list_taken() && !m_lists.empty())
+    {
+      g->reset(std::move(m_lists.back()));
+      m_lists.pop_back();
+    }
+    else
+    {
+      g->reset();
+    }
+    m_idle.push_back(std::move(g));
+  }
+  catch (...)
+  {
+  }
+}
+
+template <typename Generator>
+typename basic_generator_pool<Generator>::lease& basic_generator_pool<Generator>::lease::operator=(lease&& other) noexcept
+{
+  if (this != &other)
+  {
+    if (m_generator)
+    {
+      m_pool->release(std::move(m_generator));
+    }
+    m_pool = other.m_pool;
+    m_generator = std::move(other.m_generator);
+  }
+  return *this;
+}
+
+template <typename Generator>
+basic_generator_pool<Generator>::lease::~lease()
+{
+  if (m_generator)
+  {
+    m_pool->release(std::move(m_generator));
+  }
+}
+}  // namespace lexertk
+
+#endif  //LEXERTK_GENERATOR_POOL_IPP
@@ -6,11 +6,14 @@
 #define LEXERTK_HELPER_HPP
 
 #include "generator.hpp"
+#include "generator_pool.hpp"
 
 #include <algorithm>
 #include <map>
 #include <set>
 #include <stack>
+#include <type_traits>
+#include <utility>
 
 namespace lexertk
 {
@@ -135,8 +138,14 @@ public:
 
     for (std::size_t i = 0; i < list.size(); ++i)
     {
+      auto value = list[i].get_value();
       if (modify(list[i]))
+      {
+        // a new value only has to live until it is stored in the list
+        if (list[i].get_value().data() != value.data())
+          list[i].set_value(list.store_value(list[i].get_value()));
         changes++;
+      }
     }
 
     return changes;
@@ -186,6 +195,8 @@ public:
 
       if ((insert_index >= 0) && (insert_index <= (static_cast<int>(stride_) + 1)))
       {
+        // the value of the inserted token only has to live until it is stored in the list
+        t.set_value(list.store_value(t.get_value()));
         list.insert(list.begin() + (i + insert_index), t);
         changes++;
       }
@@ -237,6 +248,8 @@ public:
     {
       if (auto [success, t] = join(list[i], list[i + 1]); success)
       {
+        // the value of the joined token only has to live until it is stored in the list
+        t.set_value(list.store_value(t.get_value()));
         list[i] = t;
         list.erase(list.begin() + (i + 1));
 
@@ -829,20 +842,51 @@ struct helper_assembly
   lexertk::token_inserter* error_token_inserter{nullptr};
 };
 }  // namespace helper
-class parser_helper
+// Generator lexes the input of init(), its token list is what the helpers of
+// helper_assembly are run on. Lists of other types than generator's, e.g. the
+// small_token_list of small_generator, are opt-in.
+template <typename Generator = generator>
+class basic_parser_helper
 {
+  static_assert(std::is_same_v<typename Generator::token_t, token>, "parser_helper works on token objects");
+
 public:
   typedef token token_t;
-  typedef generator generator_t;
+  typedef Generator generator_t;
+  typedef typename generator_t::token_list_t token_list_t;
+
+  basic_parser_helper() = default;
+  // The token list allocates from resource.
+  explicit basic_parser_helper(std::pmr::memory_resource* resource)
+    : m_token_list{resource}
+  {
+  }
 
   inline bool init(std::string_view str)
   {
-    generator_t lexer;
-    if (!lexer.process(str))
+    // the pooled generators allocate from the default resource, the list
+    // must end up in the resource of this helper
+    if (m_token_list.get_allocator() != typename token_list_t::allocator_type{})
+    {
+      generator_t lexer{typename generator_t::Settings{}, m_token_list.get_allocator()};
+      if (!lexer.process(str))
+      {
+        return false;
+      }
+      m_token_list = std::move(lexer).get_token_list();
+      m_current_token = m_token_list.begin();
+
+      return true;
+    }
+
+    auto& pool = basic_generator_pool<generator_t>::local();
+    auto lexer = pool.acquire();
+    if (!lexer->process(str))
     {
       return false;
     }
-    m_token_list = std::move(lexer).get_token_list();
+    // the memory of the previous tokens is what the generator lexes into next
+    pool.recycle(std::exchange(m_token_list, std::move(*lexer).get_token_list()));
     m_current_token = m_token_list.begin();
 
     return true;
@@ -945,11 +989,13 @@ public:
   }
 
 protected:
-  generator_t::token_list_t m_token_list;
-  generator_t::token_list_t::iterator m_current_token;
+  token_list_t m_token_list;
+  typename token_list_t::iterator m_current_token;
 
   token m_eof_token{token::token_type::eof, token::Position{}};
 };
+
+using parser_helper = basic_parser_helper<>;
 }  // namespace lexertk
 
 #endif  //LEXERTK_HELPER_HPP
@@ -0,0 +1,205 @@
+//
+// Created by allspark on 16/10/2026.
+//
+
+#ifndef LEXERTK_KEYWORD_TABLE_HPP
+#define LEXERTK_KEYWORD_TABLE_HPP
+
+#include "token.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+
+namespace lexertk
+{
+struct keyword
+{
+  std::string_view text;
+  token::token_type type{token::token_type::keyword};
+};
+
+namespace details
+{
+// Length, first, middle and last byte of a word packed into one key.
+constexpr std::uint32_t keyword_key(std::string_view text) noexcept
+{
+  auto byte = [&](std::size_t i) { return static_cast<std::uint32_t>(static_cast<unsigned char>(text[i])); };
+  return static_cast<std::uint32_t>(text.size() & 0xFF) | (byte(0) << 8) | (byte(text.size() / 2) << 16) | (byte(text.size() - 1) << 24);
+}
+
+struct keyword_slot
+{
+  std::string_view text;
+  std::uint32_t key{0};
+  // 1 + index of the next slot holding a keyword with the same key, 0 for none
+  std::uint16_t next{0};
+  token::token_type type{token::token_type::none};
+};
+}  // namespace details
+
+// Non-owning view of a keyword_table, this is what generator::Settings holds.
+// The table it refers to must outlive it, e.g. by being a constexpr variable.
+class keyword_set
+{
+public:
+  constexpr keyword_set() noexcept = default;
+  constexpr keyword_set(const details::keyword_slot* slots, std::uint32_t multiplier, unsigned shift, std::size_t max_length) noexcept
+    : m_slots{slots}
+    , m_multiplier{multiplier}
+    , m_shift{shift}
+    , m_max_length{max_length}
+  {
+  }
+
+  // Type of the keyword spelled by symbol, or token_type::symbol if there is none.
+  constexpr token::token_type classify(std::string_view symbol) const noexcept
+  {
+    if (symbol.empty() || symbol.size() > m_max_length)
+    {
+      return token::token_type::symbol;
+    }
+
+    auto key = details::keyword_key(symbol);
+    const details::keyword_slot* slot = &m_slots[static_cast<std::uint32_t>(key * m_multiplier) >> m_shift];
+    if (slot->key != key)
+    {
+      return token::token_type::symbol;
+    }
+    // keywords sharing a key are chained behind the first one
+    while (slot->text != symbol)
+    {
+      if (slot->next == 0)
+      {
+        return token::token_type::symbol;
+      }
+      slot = &m_slots[slot->next - 1];
+    }
+    return slot->type;
+  }
+
+private:
+  const details::keyword_slot* m_slots{nullptr};
+  std::uint32_t m_multiplier{0};
+  unsigned m_shift{0};
+  std::size_t m_max_length{0};
+};
+
+// Collision free multiplicative hash over the keys of a fixed keyword set,
+// found at compile time: slot = (key * multiplier) >> (32 - bits). A lookup
+// costs one hash, one key compare and one string compare however many
+// keywords there are. Keywords with the same length, first, middle and last
+// byte share a key, all but the first of them go to free slots chained behind
+// it and cost a string compare each.
+template <std::size_t N>
+class keyword_table
+{
+  static_assert(N > 0, "a keyword table needs at least one keyword");
+
+public:
+  static constexpr std::size_t bits = std::countr_zero(std::bit_ceil(4 * N));
+  static constexpr std::size_t size = std::size_t{1} << bits;
+  static_assert(size <= std::numeric_limits<std::uint16_t>::max(), "slots are chained through 16 bit indices");
+
+  explicit constexpr keyword_table(keyword const (&keywords)[N]) noexcept
+  {
+    for (auto const& kw : keywords)
+    {
+      m_max_length = std::max(m_max_length, kw.text.size());
+    }
+
+    for (std::uint32_t candidate = 0x9E3779B1u;; candidate += 2)
+    {
+      if (try_build(keywords, candidate))
+      {
+        m_multiplier = candidate;
+        break;
+      }
+    }
+    chain_shared_keys(keywords);
+  }
+
+  constexpr operator keyword_set() const noexcept
+  {
+    return {m_slots.data(), m_multiplier, 32 - bits, m_max_length};
+  }
+
+  constexpr token::token_type classify(std::string_view symbol) const noexcept
+  {
+    return keyword_set{*this}.classify(symbol);
+  }
+
+private:
+  static constexpr std::size_t index(std::uint32_t key, std::uint32_t m) noexcept
+  {
+    return static_cast<std::uint32_t>(key * m) >> (32 - bits);
+  }
+
+  // places the first keyword of every key
+  constexpr bool try_build(keyword const (&keywords)[N], std::uint32_t m) noexcept
+  {
+    m_slots = {};
+    for (auto const& kw : keywords)
+    {
+      auto key = details::keyword_key(kw.text);
+      auto& slot = m_slots[index(key, m)];
+      if (slot.key == key)
+      {
+        continue;
+      }
+      if (slot.key != 0)
+      {
+        return false;
+      }
+      slot = {kw.text, key, 0, kw.type};
+    }
+    return true;
+  }
+
+  // appends the other keywords of a key to the chain of its first one, in
+  // slots no key hashes to
+  constexpr void chain_shared_keys(keyword const (&keywords)[N]) noexcept
+  {
+    std::size_t free = 0;
+    for (auto const& kw : keywords)
+    {
+      auto key = details::keyword_key(kw.text);
+      auto* slot = &m_slots[index(key, m_multiplier)];
+      while (slot->text != kw.text && slot->next != 0)
+      {
+        slot = &m_slots[slot->next - 1];
+      }
+      if (slot->text == kw.text)
+      {
+        continue;
+      }
+      while (m_slots[free].key != 0)
+      {
+        ++free;
+      }
+      m_slots[free] = {kw.text, key, 0, kw.type};
+      slot->next = static_cast<std::uint16_t>(free + 1);
+    }
+  }
+
+  std::uint32_t m_multiplier{0};
+  std::size_t m_max_length{0};
+  std::array<details::keyword_slot, size> m_slots{};
+};
+
+// Keywords recognised unless generator::Settings says otherwise.
+inline constexpr keyword_table default_keywords{{
+    {"true", token::token_type::boolean},
+    {"false", token::token_type::boolean},
+}};
+
+static_assert(default_keywords.classify("true") == token::token_type::boolean);
+static_assert(default_keywords.classify("tree") == token::token_type::symbol);
+static_assert(default_keywords.classify("falsey") == token::token_type::symbol);
+}  // namespace lexertk
+
+#endif  //LEXERTK_KEYWORD_TABLE_HPP
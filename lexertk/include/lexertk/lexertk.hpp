@@ -41,5 +41,7 @@
 
 #include "token.hpp"
 #include "generator.hpp"
+#include "dfa_generator.hpp"
+#include "generator_pool.hpp"
 
 #endif  //LEXERTK_LEXERTK_HPP
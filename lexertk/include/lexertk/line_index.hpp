@@ -0,0 +1,54 @@
+//
+// Created by allspark on 16/10/2026.
+//
+
+#ifndef LEXERTK_LINE_INDEX_HPP
+#define LEXERTK_LINE_INDEX_HPP
+
+#include "token.hpp"
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace lexertk
+{
+// Maps locations inside lexed input back to line/column positions. Only the
+// offsets of line starts are recorded, positions are resolved on demand by a
+// binary search over the indexed texts and one over their line starts.
+class line_index
+{
+public:
+  line_index() = default;
+
+  // Indexes text whose first byte is on the given line.
+  inline void add(std::string_view text, std::size_t first_line);
+  inline void clear() noexcept;
+
+  // Number of lines spanned by all indexed text.
+  inline std::size_t line_count() const noexcept;
+
+  // Returns a default constructed Position if location is outside all indexed text.
+  template <typename Position = token::Position>
+  inline Position resolve(const char* location) const noexcept;
+
+private:
+  struct segment
+  {
+    const char* begin;
+    const char* end;
+    std::size_t first_line;
+    // [first, last) into m_line_starts, offsets relative to begin
+    std::size_t first;
+    std::size_t last;
+  };
+
+  // sorted by begin, not overlapping
+  std::vector<segment> m_segments;
+  std::vector<std::size_t> m_line_starts;
+};
+}  // namespace lexertk
+
+#include "line_index.ipp"
+
+#endif  //LEXERTK_LINE_INDEX_HPP
@@ -0,0 +1,90 @@
+//
+// Created by allspark on 16/10/2026.
+//
+
+#ifndef LEXERTK_LINE_INDEX_IPP
+#define LEXERTK_LINE_INDEX_IPP
+
+#include "simd.hpp"
+
+#include <algorithm>
+#include <functional>
+
+namespace lexertk
+{
+void line_index::add(std::string_view text, std::size_t first_line)
+{
+  segment seg{text.data(), text.data() + text.size(), first_line, m_line_starts.size(), 0};
+
+  for (std::size_t offset = 0; offset < text.size();)
+  {
+    offset += details::simd::find_newline(text.data() + offset, seg.end);
+    if (offset++ < text.size())
+    {
+      m_line_starts.push_back(offset);
+    }
+  }
+
+  seg.last = m_line_starts.size();
+
+  // Segments are kept sorted by address. Text overlapping an indexed one
+  // reuses its memory, so that input is gone and its segment is dropped.
+  auto pos = std::upper_bound(m_segments.begin(), m_segments.end(), seg, [](segment const& a, segment const& b)
+      {
+        return std::less<const char*>{}(a.begin, b.begin) || (a.begin == b.begin && std::less<const char*>{}(a.end, b.end));
+      });
+  auto overlaps = [&seg](segment const& s)
+  {
+    return std::less<const char*>{}(s.begin, seg.end) && std::less<const char*>{}(seg.begin, s.end);
+  };
+  auto first = pos;
+  while (first != m_segments.begin() && overlaps(*(first - 1)))
+  {
+    --first;
+  }
+  auto last = std::find_if_not(pos, m_segments.end(), overlaps);
+  m_segments.insert(m_segments.erase(first, last), seg);
+}
+
+void line_index::clear() noexcept
+{
+  m_segments.clear();
+  m_line_starts.clear();
+}
+
+std::size_t line_index::line_count() const noexcept
+{
+  std::size_t lines = 0;
+  for (auto const& seg : m_segments)
+  {
+    lines += seg.last - seg.first + 1;
+  }
+  return lines;
+}
+
+template <typename Position>
+Position line_index::resolve(const char* location) const noexcept
+{
+  // the segments do not overlap, so their ends are sorted as well and only
+  // the last one starting at or before location can hold it
+  auto seg = std::upper_bound(m_segments.begin(), m_segments.end(), location, [](const char* l, segment const& s)
+      {
+        return std::less<const char*>{}(l, s.begin);
+      });
+
+  if (seg == m_segments.begin() || std::less<const char*>{}((--seg)->end, location))
+  {
+    return {};
+  }
+
+  auto offset = static_cast<std::size_t>(location - seg->begin);
+  auto first = m_line_starts.begin() + seg->first;
+  auto next = std::upper_bound(first, m_line_starts.begin() + seg->last, offset);
+  auto line_start = (next == first) ? std::size_t{0} : *(next - 1);
+
+  return {static_cast<typename Position::value_type>(seg->first_line + (next - first)),
+      static_cast<typename Position::value_type>(1 + offset - line_start)};
+}
+}  // namespace lexertk
+
+#endif  //LEXERTK_LINE_INDEX_IPP
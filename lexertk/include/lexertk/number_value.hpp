@@ -0,0 +1,42 @@
+//
+// Created by allspark on 17/10/2026.
+//
+
+#ifndef LEXERTK_NUMBER_VALUE_HPP
+#define LEXERTK_NUMBER_VALUE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <variant>
+
+namespace lexertk
+{
+// Value of a number token, converted while lexing when
+// generator_settings::parse_numbers is set.
+struct number_value
+{
+  using value_type = std::variant<std::int64_t, double>;
+
+  // index of the token in the generator's token list
+  std::size_t token;
+  // integer literals as int64, everything else as double
+  value_type value;
+};
+
+// The value of the token at index token, nullptr if it is not a number.
+inline number_value const* find_number(std::span<const number_value> numbers, std::size_t token) noexcept;
+
+namespace details
+{
+// Converts the text of a number token. Returns false for integers that
+// overflow int64, reals outside the range of double and reals with more
+// than 17 significant digits, which a double can not keep.
+inline bool convert_number(std::string_view text, number_value::value_type& value) noexcept;
+}  // namespace details
+}  // namespace lexertk
+
+#include "number_value.ipp"
+
+#endif  //LEXERTK_NUMBER_VALUE_HPP
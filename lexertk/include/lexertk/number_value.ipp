@@ -0,0 +1,97 @@
+//
+// Created by allspark on 17/10/2026.
+//
+
+#ifndef LEXERTK_NUMBER_VALUE_IPP
+#define LEXERTK_NUMBER_VALUE_IPP
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <system_error>
+
+namespace lexertk
+{
+number_value const* find_number(std::span<const number_value> numbers, std::size_t token) noexcept
+{
+  auto it = std::lower_bound(numbers.begin(), numbers.end(), token, [](number_value const& n, std::size_t t) { return n.token < t; });
+  return (it != numbers.end() && it->token == token) ? std::to_address(it) : nullptr;
+}
+
+namespace details
+{
+namespace number
+{
+// Value of eight ASCII digits, see Lemire's "Number Parsing at a Gigabyte per
+// Second": adjacent digits are combined pairwise in 3 multiplications.
+inline std::uint32_t eight_digits(const char* it) noexcept
+{
+  std::uint64_t v;
+  std::memcpy(&v, it, sizeof(v));
+  v -= 0x3030303030303030;
+  v = (v * 10) + (v >> 8);
+  v = (((v & 0x000000FF000000FF) * (100 + (1000000ULL << 32))) + (((v >> 16) & 0x000000FF000000FF) * (1 + (10000ULL << 32)))) >> 32;
+  return static_cast<std::uint32_t>(v);
+}
+
+// up to 18 digits can not overflow an int64
+inline constexpr std::size_t max_short_integer = 18;
+// digits a double holds, further ones would be rounded away
+inline constexpr std::size_t max_real_digits = 17;
+
+// Digits from the first to the last non-zero one of the mantissa.
+inline std::size_t significant_digits(const char* it, const char* end) noexcept
+{
+  auto mantissa_end = std::find_if(it, end, [](char c) { return c == 'e' || c == 'E'; });
+  auto first = std::find_if(it, mantissa_end, [](char c) { return c >= '1' && c <= '9'; });
+  if (first == mantissa_end)
+  {
+    return 0;
+  }
+  auto last = std::find_if(std::make_reverse_iterator(mantissa_end), std::make_reverse_iterator(first), [](char c) { return c >= '1' && c <= '9'; }).base();
+  return static_cast<std::size_t>(std::count_if(first, last, [](char c) { return c != '.'; }));
+}
+}  // namespace number
+
+bool convert_number(std::string_view text, number_value::value_type& value) noexcept
+{
+  const char* it = text.data();
+  const char* const end = it + text.size();
+
+  if (text.size() <= number::max_short_integer && std::all_of(it, end, [](char c) { return c >= '0' && c <= '9'; }))
+  {
+    std::uint64_t v = 0;
+    // the byte order of eight_digits is the little endian one
+    for (; std::endian::native == std::endian::little && end - it >= 8; it += 8)
+    {
+      v = v * 100000000 + number::eight_digits(it);
+    }
+    for (; it != end; ++it)
+    {
+      v = v * 10 + static_cast<std::uint64_t>(*it - '0');
+    }
+    value = static_cast<std::int64_t>(v);
+    return true;
+  }
+
+  // longer integers and reals, from_chars is exact and rejects out of range values
+  if (std::none_of(it, end, [](char c) { return c == '.' || c == 'e' || c == 'E'; }))
+  {
+    std::int64_t v{0};
+    auto [ptr, ec] = std::from_chars(it, end, v);
+    value = v;
+    return ec == std::errc{} && ptr == end;
+  }
+
+  double v{0};
+  auto [ptr, ec] = std::from_chars(it, end, v);
+  value = v;
+  return ec == std::errc{} && ptr == end && number::significant_digits(it, end) <= number::max_real_digits;
+}
+}  // namespace details
+}  // namespace lexertk
+
+#endif  //LEXERTK_NUMBER_VALUE_IPP
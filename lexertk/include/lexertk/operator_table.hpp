@@ -0,0 +1,130 @@
+//
+// Created by allspark on 16/10/2026.
+//
+
+#ifndef LEXERTK_OPERATOR_TABLE_HPP
+#define LEXERTK_OPERATOR_TABLE_HPP
+
+#include "token.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace lexertk
+{
+namespace details
+{
+struct compound_operator
+{
+  std::string_view text;
+  token::token_type type;
+};
+
+// Operators spelled with more than one character. Anything else starting with
+// an operator character is lexed as a single character operator.
+inline constexpr std::array<compound_operator, 11> compound_operators{{
+    {"<=", token::token_type::lte},
+    {">=", token::token_type::gte},
+    {"<>", token::token_type::ne},
+    {"!=", token::token_type::ne},
+    {"==", token::token_type::eq},
+    {":=", token::token_type::rebind},
+    {"<<", token::token_type::shl},
+    {">>", token::token_type::shr},
+    {"::", token::token_type::scope},
+    {"&&", token::token_type::logical_and},
+    {"||", token::token_type::logical_or},
+}};
+
+// Packs up to four operator characters into one key, first character in the
+// most significant used byte. Keys of different lengths never compare equal
+// because operator characters are never zero.
+constexpr std::uint32_t operator_key(std::string_view text) noexcept
+{
+  std::uint32_t key = 0;
+  for (char c : text)
+  {
+    key = (key << 8) | static_cast<unsigned char>(c);
+  }
+  return key;
+}
+
+// Collision free multiplicative hash over the keys of a fixed operator set,
+// found at compile time: slot = (key * multiplier) >> (32 - bits).
+template <std::size_t N>
+class operator_hash
+{
+public:
+  static constexpr std::size_t bits = std::countr_zero(std::bit_ceil(2 * N));
+  static constexpr std::size_t size = std::size_t{1} << bits;
+
+  explicit constexpr operator_hash(std::array<compound_operator, N> const& operators) noexcept
+  {
+    for (auto const& op : operators)
+    {
+      max_length = std::max(max_length, op.text.size());
+    }
+
+    for (std::uint32_t candidate = 0x9E3779B1u;; candidate += 2)
+    {
+      if (try_build(operators, candidate))
+      {
+        multiplier = candidate;
+        break;
+      }
+    }
+  }
+
+  constexpr token::token_type find(std::uint32_t key) const noexcept
+  {
+    auto const& slot = slots[index(key, multiplier)];
+    return slot.key == key ? slot.type : token::token_type::none;
+  }
+
+  std::size_t max_length{0};
+
+private:
+  struct slot_t
+  {
+    std::uint32_t key{0};
+    token::token_type type{token::token_type::none};
+  };
+
+  static constexpr std::size_t index(std::uint32_t key, std::uint32_t m) noexcept
+  {
+    return static_cast<std::uint32_t>(key * m) >> (32 - bits);
+  }
+
+  constexpr bool try_build(std::array<compound_operator, N> const& operators, std::uint32_t m) noexcept
+  {
+    slots = {};
+    for (auto const& op : operators)
+    {
+      auto key = operator_key(op.text);
+      auto& slot = slots[index(key, m)];
+      if (slot.key != 0)
+      {
+        return false;
+      }
+      slot = {key, op.type};
+    }
+    return true;
+  }
+
+  std::uint32_t multiplier{0};
+  std::array<slot_t, size> slots{};
+};
+
+inline constexpr operator_hash<compound_operators.size()> operator_table{compound_operators};
+
+static_assert(operator_table.max_length <= 4, "operator keys hold at most four characters");
+static_assert(operator_table.find(operator_key("<=")) == token::token_type::lte);
+static_assert(operator_table.find(operator_key("=<")) == token::token_type::none);
+}  // namespace details
+}  // namespace lexertk
+
+#endif  //LEXERTK_OPERATOR_TABLE_HPP
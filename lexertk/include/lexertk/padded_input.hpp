@@ -0,0 +1,48 @@
+//
+// Created by allspark on 16/10/2026.
+//
+
+#ifndef LEXERTK_PADDED_INPUT_HPP
+#define LEXERTK_PADDED_INPUT_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace lexertk
+{
+// Input text followed by at least padding zero bytes in the same buffer. The
+// scanners read ahead into the padding instead of checking for the end of the
+// input: a zero byte ends every whitespace, symbol and number run.
+class padded_input
+{
+public:
+  static constexpr std::size_t padding = 64;
+
+  // The caller guarantees text.data()[text.size()] up to
+  // text.data()[text.size() + padding - 1] are readable and zero.
+  constexpr explicit padded_input(std::string_view text) noexcept
+    : m_text{text}
+  {
+  }
+
+  // Appends the padding to buffer and returns a view of its previous
+  // content. The buffer must not be modified while the view is in use.
+  static padded_input pad(std::string& buffer)
+  {
+    auto size = buffer.size();
+    buffer.append(padding, '\0');
+    return padded_input{std::string_view{buffer}.substr(0, size)};
+  }
+
+  constexpr std::string_view text() const noexcept
+  {
+    return m_text;
+  }
+
+private:
+  std::string_view m_text;
+};
+}  // namespace lexertk
+
+#endif  //LEXERTK_PADDED_INPUT_HPP
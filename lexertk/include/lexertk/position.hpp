@@ -0,0 +1,63 @@
+//
+// Created by allspark on 17/10/2026.
+//
+
+#ifndef LEXERTK_POSITION_HPP
+#define LEXERTK_POSITION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+
+namespace lexertk
+{
+// Position policies, the type a token records its position in. A generator
+// keeps only the bookkeeping its tokens' policy needs.
+
+// Line and column, both starting at 1. Values past the range of T wrap.
+template <typename T>
+struct line_column_position
+{
+  using iterator = std::string_view::const_iterator;
+  using value_type = T;
+
+  value_type line{std::numeric_limits<value_type>::max()};
+  value_type column{std::numeric_limits<value_type>::max()};
+
+  inline line_column_position IncrementColumn(iterator begin, iterator end) noexcept;
+  inline void NextLine(std::size_t count = 1) noexcept;
+  inline void NextColumn(std::size_t count = 1) noexcept;
+};
+
+using position16 = line_column_position<std::uint16_t>;
+using position32 = line_column_position<std::uint32_t>;
+
+// Offset of the token's first byte, counted as if all inputs lexed by one
+// generator were joined by newlines.
+struct offset_position
+{
+  using value_type = std::size_t;
+
+  value_type offset{std::numeric_limits<value_type>::max()};
+};
+
+// No position at all, tokens record nothing and the generator does not
+// count lines.
+struct no_position
+{
+};
+
+template <typename Position>
+inline constexpr bool has_line_column = requires(Position const& p) {
+  p.line;
+  p.column;
+};
+
+template <typename Position>
+inline constexpr bool has_offset = requires(Position const& p) { p.offset; };
+}  // namespace lexertk
+
+#include "position.ipp"
+
+#endif  //LEXERTK_POSITION_HPP
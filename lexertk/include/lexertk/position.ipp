@@ -0,0 +1,37 @@
+//
+// Created by allspark on 17/10/2026.
+//
+
+#ifndef LEXERTK_POSITION_IPP
+#define LEXERTK_POSITION_IPP
+
+#include <iterator>
+
+namespace lexertk
+{
+template <typename T>
+line_column_position<T> line_column_position<T>::IncrementColumn(iterator begin, iterator end) noexcept
+{
+  std::size_t off = std::distance(begin, end);
+  line_column_position tmp{*this};
+
+  column += static_cast<value_type>(off);
+
+  return tmp;
+}
+
+template <typename T>
+void line_column_position<T>::NextLine(std::size_t count) noexcept
+{
+  line += static_cast<value_type>(count);
+  column = 1;
+}
+
+template <typename T>
+void line_column_position<T>::NextColumn(std::size_t count) noexcept
+{
+  column += static_cast<value_type>(count);
+}
+}  // namespace lexertk
+
+#endif  //LEXERTK_POSITION_IPP
@@ -0,0 +1,59 @@
+//
+// Created by allspark on 17/10/2026.
+//
+
+#ifndef LEXERTK_RESERVATION_POLICY_HPP
+#define LEXERTK_RESERVATION_POLICY_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace lexertk
+{
+// Decides how much room a generator reserves in its token list. The number of
+// tokens per input byte is learned from the lines lexed so far, a reservation
+// never covers more than limit tokens for one line, and a list that kept the
+// capacity of a rare huge input is shrunk again on reset.
+class reservation_policy
+{
+public:
+  static constexpr std::size_t default_limit = std::size_t{1} << 16;
+
+  explicit reservation_policy(std::size_t limit = default_limit) noexcept
+    : m_limit{limit}
+  {
+  }
+
+  // Tokens expected from bytes of input.
+  inline std::size_t estimate(std::size_t bytes) const noexcept;
+  // Capacity to reserve before lexing bytes of input into a list holding size
+  // tokens with room for capacity, 0 if the list is large enough.
+  inline std::size_t reserve_for(std::size_t bytes, std::size_t size, std::size_t capacity) const noexcept;
+  // Learns from a line of bytes that produced tokens.
+  inline void record(std::size_t bytes, std::size_t tokens) noexcept;
+  // Called on reset with the tokens and capacity of the list about to be
+  // cleared, returns the capacity to shrink it to or 0 to keep it.
+  inline std::size_t shrink_to(std::size_t tokens, std::size_t capacity) noexcept;
+
+private:
+  // tokens per byte are kept in 1/1024
+  static constexpr std::uint32_t ratio_scale = 1024;
+  // resets the peak token count is taken over
+  static constexpr std::size_t window = 16;
+  // capacity never shrunk below, and how far above the peak it may grow
+  static constexpr std::size_t min_capacity = 1024;
+  static constexpr std::size_t spike_factor = 4;
+
+  std::size_t m_limit;
+  // one token every two bytes until something was lexed
+  std::uint32_t m_ratio{ratio_scale / 2};
+  // peak of the current and of the last complete window
+  std::size_t m_peak{0};
+  std::size_t m_last_peak{0};
+  std::size_t m_resets{0};
+};
+}  // namespace lexertk
+
+#include "reservation_policy.ipp"
+
+#endif  //LEXERTK_RESERVATION_POLICY_HPP
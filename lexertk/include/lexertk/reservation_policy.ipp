@@ -0,0 +1,59 @@
+//
+// Created by allspark on 17/10/2026.
+//
+
+#ifndef LEXERTK_RESERVATION_POLICY_IPP
+#define LEXERTK_RESERVATION_POLICY_IPP
+
+#include <algorithm>
+#include <utility>
+
+namespace lexertk
+{
+std::size_t reservation_policy::estimate(std::size_t bytes) const noexcept
+{
+  // a quarter more than the learned ratio, and the eol token
+  auto tokens = bytes / ratio_scale * m_ratio + bytes % ratio_scale * m_ratio / ratio_scale;
+  return std::min(tokens + tokens / 4 + 1, m_limit);
+}
+
+std::size_t reservation_policy::reserve_for(std::size_t bytes, std::size_t size, std::size_t capacity) const noexcept
+{
+  auto needed = size + estimate(bytes);
+  if (needed <= capacity)
+  {
+    return 0;
+  }
+  // grow geometrically, a list filled line by line must not reallocate per line
+  return std::max(needed, capacity + capacity / 2);
+}
+
+void reservation_policy::record(std::size_t bytes, std::size_t tokens) noexcept
+{
+  if (bytes == 0)
+  {
+    return;
+  }
+  auto ratio = static_cast<std::uint32_t>(std::min<std::size_t>(tokens * ratio_scale / bytes, 4 * ratio_scale));
+  m_ratio = (7 * m_ratio + ratio) / 8;
+}
+
+std::size_t reservation_policy::shrink_to(std::size_t tokens, std::size_t capacity) noexcept
+{
+  m_peak = std::max(m_peak, tokens);
+  if (++m_resets == window)
+  {
+    m_last_peak = std::exchange(m_peak, 0);
+    m_resets = 0;
+  }
+
+  auto peak = std::max({m_peak, m_last_peak, tokens});
+  if (capacity <= min_capacity || capacity <= spike_factor * peak)
+  {
+    return 0;
+  }
+  return std::max(2 * peak, min_capacity);
+}
+}  // namespace lexertk
+
+#endif  //LEXERTK_RESERVATION_POLICY_IPP
@@ -0,0 +1,833 @@
+//
+// Created by allspark on 16/10/2026.
+//
+
+#ifndef LEXERTK_SIMD_HPP
+#define LEXERTK_SIMD_HPP
+
+#include "cpu_features.hpp"
+#include "detail.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#if defined(LEXERTK_SIMD_DISPATCH)
+#  include <immintrin.h>
+#endif
+
+// Kernels for a level above the compiler's baseline are compiled for that
+// level's instruction set only and are never called unless the CPU has it.
+#if defined(LEXERTK_SIMD_DISPATCH) && (defined(__GNUC__) || defined(__clang__))
+#  define LEXERTK_TARGET(isa) __attribute__((target(isa)))
+#else
+#  define LEXERTK_TARGET(isa)
+#endif
+
+#define LEXERTK_TARGET_SSE4_2 LEXERTK_TARGET("sse4.2,popcnt")
+#define LEXERTK_TARGET_AVX2 LEXERTK_TARGET("avx2,bmi,bmi2,popcnt")
+#define LEXERTK_TARGET_AVX512 LEXERTK_TARGET("avx512f,avx512bw,avx2,bmi,bmi2,popcnt")
+
+namespace lexertk
+{
+namespace details
+{
+namespace simd
+{
+// A run of skipped bytes together with the newlines it contains.
+struct text_run
+{
+  std::size_t length{0};
+  std::size_t newlines{0};
+  // offset just past the last '\n' of the run, only meaningful if newlines != 0
+  std::size_t line_start{0};
+};
+
+template <bool Padded = false>
+inline text_run scan_whitespace_scalar(const char* begin, const char* end, text_run run = {}) noexcept
+{
+  const char* it = begin + run.length;
+  while ((Padded || it != end) && is_whitespace(*it))
+  {
+    if (*it == '\n')
+    {
+      ++run.newlines;
+      run.line_start = static_cast<std::size_t>(it - begin) + 1;
+    }
+    ++it;
+  }
+  run.length = static_cast<std::size_t>(it - begin);
+  return run;
+}
+
+// Advances the run by the first count bytes of a block, adding the newlines
+// among them from the block's newline bit mask.
+template <typename Mask>
+void advance_run(text_run& run, Mask nl_mask, int count) noexcept
+{
+  constexpr int width = std::numeric_limits<Mask>::digits;
+
+  if (count != width)
+  {
+    nl_mask &= static_cast<Mask>((Mask{1} << count) - 1);
+  }
+
+  if (nl_mask)
+  {
+    run.newlines += static_cast<std::size_t>(std::popcount(nl_mask));
+    run.line_start = run.length + static_cast<std::size_t>(width - std::countl_zero(nl_mask));
+  }
+  run.length += static_cast<std::size_t>(count);
+}
+
+// Folds one block worth of whitespace/newline bit masks into the run. Returns
+// true if the block contained a non-whitespace byte, i.e. the run is complete.
+template <typename Mask>
+bool accumulate_whitespace_block(text_run& run, Mask ws_mask, Mask nl_mask) noexcept
+{
+  constexpr int width = std::numeric_limits<Mask>::digits;
+
+  Mask stop = static_cast<Mask>(~ws_mask);
+  int skipped = stop ? std::countr_zero(stop) : width;
+  advance_run(run, nl_mask, skipped);
+
+  return skipped != width;
+}
+
+#if defined(LEXERTK_SIMD_DISPATCH)
+template <bool Padded = false>
+LEXERTK_TARGET_AVX2 inline text_run scan_whitespace_avx2(const char* begin, const char* end) noexcept
+{
+  text_run run;
+  const __m256i space = _mm256_set1_epi8(' ');
+  const __m256i newline = _mm256_set1_epi8('\n');
+  const __m256i ctrl_base = _mm256_set1_epi8('\b');
+  const __m256i ctrl_span = _mm256_set1_epi8('\r' - '\b');
+
+  // padded input ends in zero bytes, which stop the run, so whole blocks can be read
+  while (Padded || end - (begin + run.length) >= 32)
+  {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin + run.length));
+    // '\b'..'\r' is one contiguous range: (c - '\b') <= 5 as unsigned
+    __m256i ctrl = _mm256_sub_epi8(v, ctrl_base);
+    __m256i is_ctrl = _mm256_cmpeq_epi8(_mm256_min_epu8(ctrl, ctrl_span), ctrl);
+    __m256i is_ws = _mm256_or_si256(is_ctrl, _mm256_cmpeq_epi8(v, space));
+
+    auto ws_mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(is_ws));
+    auto nl_mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, newline)));
+    if (accumulate_whitespace_block(run, ws_mask, nl_mask))
+    {
+      return run;
+    }
+  }
+
+  return scan_whitespace_scalar<Padded>(begin, end, run);
+}
+
+template <bool Padded = false>
+LEXERTK_TARGET_SSE4_2 inline text_run scan_whitespace_sse4_2(const char* begin, const char* end) noexcept
+{
+  text_run run;
+  const __m128i space = _mm_set1_epi8(' ');
+  const __m128i newline = _mm_set1_epi8('\n');
+  const __m128i ctrl_base = _mm_set1_epi8('\b');
+  const __m128i ctrl_span = _mm_set1_epi8('\r' - '\b');
+
+  while (Padded || end - (begin + run.length) >= 16)
+  {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin + run.length));
+    __m128i ctrl = _mm_sub_epi8(v, ctrl_base);
+    __m128i is_ctrl = _mm_cmpeq_epi8(_mm_min_epu8(ctrl, ctrl_span), ctrl);
+    __m128i is_ws = _mm_or_si128(is_ctrl, _mm_cmpeq_epi8(v, space));
+
+    auto ws_mask = static_cast<std::uint16_t>(_mm_movemask_epi8(is_ws));
+    auto nl_mask = static_cast<std::uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, newline)));
+    if (accumulate_whitespace_block(run, ws_mask, nl_mask))
+    {
+      return run;
+    }
+  }
+
+  return scan_whitespace_scalar<Padded>(begin, end, run);
+}
+
+// The AVX-512 kernels load the tail of the input through a byte mask instead of
+// falling back to scalar code. Masked out bytes read as zero, which is neither
+// whitespace, a symbol character nor one of the bytes a string or comment stops on.
+constexpr std::uint64_t block_mask(std::ptrdiff_t remaining) noexcept
+{
+  return remaining >= 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << remaining) - 1;
+}
+
+LEXERTK_TARGET_AVX512 inline text_run scan_whitespace_avx512(const char* begin, const char* end) noexcept
+{
+  text_run run;
+  const __m512i space = _mm512_set1_epi8(' ');
+  const __m512i newline = _mm512_set1_epi8('\n');
+  const __m512i ctrl_base = _mm512_set1_epi8('\b');
+  const __m512i ctrl_span = _mm512_set1_epi8('\r' - '\b');
+
+  while (begin + run.length != end)
+  {
+    __m512i v = _mm512_maskz_loadu_epi8(block_mask(end - (begin + run.length)), begin + run.length);
+    std::uint64_t ws_mask = _mm512_cmple_epu8_mask(_mm512_sub_epi8(v, ctrl_base), ctrl_span) | _mm512_cmpeq_epi8_mask(v, space);
+    std::uint64_t nl_mask = _mm512_cmpeq_epi8_mask(v, newline);
+    if (accumulate_whitespace_block(run, ws_mask, nl_mask))
+    {
+      return run;
+    }
+  }
+
+  return run;
+}
+#endif
+
+template <bool Padded = false>
+inline std::size_t scan_symbol_scalar(const char* begin, const char* end, std::size_t length = 0) noexcept
+{
+  const char* it = begin + length;
+  while ((Padded || it != end) && is_symbol_char(*it))
+  {
+    ++it;
+  }
+  return static_cast<std::size_t>(it - begin);
+}
+
+#if defined(LEXERTK_SIMD_DISPATCH)
+template <bool Padded = false>
+LEXERTK_TARGET_AVX2 inline std::size_t scan_symbol_avx2(const char* begin, const char* end) noexcept
+{
+  std::size_t length = 0;
+  const __m256i lower = _mm256_set1_epi8(0x20);
+  const __m256i alpha_base = _mm256_set1_epi8('a');
+  const __m256i alpha_span = _mm256_set1_epi8('z' - 'a');
+  const __m256i digit_base = _mm256_set1_epi8('0');
+  const __m256i digit_span = _mm256_set1_epi8('9' - '0');
+  const __m256i underscore = _mm256_set1_epi8('_');
+
+  while (Padded || end - (begin + length) >= 32)
+  {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin + length));
+    // folding case maps 'A'..'Z' onto 'a'..'z', both ranges are then unsigned span compares
+    __m256i alpha = _mm256_sub_epi8(_mm256_or_si256(v, lower), alpha_base);
+    __m256i digit = _mm256_sub_epi8(v, digit_base);
+    __m256i is_alpha = _mm256_cmpeq_epi8(_mm256_min_epu8(alpha, alpha_span), alpha);
+    __m256i is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, digit_span), digit);
+    __m256i is_symbol = _mm256_or_si256(_mm256_or_si256(is_alpha, is_digit), _mm256_cmpeq_epi8(v, underscore));
+
+    auto stop = ~static_cast<std::uint32_t>(_mm256_movemask_epi8(is_symbol));
+    if (stop)
+    {
+      return length + static_cast<std::size_t>(std::countr_zero(stop));
+    }
+    length += 32;
+  }
+
+  return scan_symbol_scalar<Padded>(begin, end, length);
+}
+
+template <bool Padded = false>
+LEXERTK_TARGET_SSE4_2 inline std::size_t scan_symbol_sse4_2(const char* begin, const char* end) noexcept
+{
+  std::size_t length = 0;
+  const __m128i lower = _mm_set1_epi8(0x20);
+  const __m128i alpha_base = _mm_set1_epi8('a');
+  const __m128i alpha_span = _mm_set1_epi8('z' - 'a');
+  const __m128i digit_base = _mm_set1_epi8('0');
+  const __m128i digit_span = _mm_set1_epi8('9' - '0');
+  const __m128i underscore = _mm_set1_epi8('_');
+
+  while (Padded || end - (begin + length) >= 16)
+  {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin + length));
+    __m128i alpha = _mm_sub_epi8(_mm_or_si128(v, lower), alpha_base);
+    __m128i digit = _mm_sub_epi8(v, digit_base);
+    __m128i is_alpha = _mm_cmpeq_epi8(_mm_min_epu8(alpha, alpha_span), alpha);
+    __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digit, digit_span), digit);
+    __m128i is_symbol = _mm_or_si128(_mm_or_si128(is_alpha, is_digit), _mm_cmpeq_epi8(v, underscore));
+
+    auto stop = static_cast<std::uint16_t>(~_mm_movemask_epi8(is_symbol));
+    if (stop)
+    {
+      return length + static_cast<std::size_t>(std::countr_zero(stop));
+    }
+    length += 16;
+  }
+
+  return scan_symbol_scalar<Padded>(begin, end, length);
+}
+
+LEXERTK_TARGET_AVX512 inline std::size_t scan_symbol_avx512(const char* begin, const char* end) noexcept
+{
+  std::size_t length = 0;
+  const __m512i lower = _mm512_set1_epi8(0x20);
+  const __m512i alpha_base = _mm512_set1_epi8('a');
+  const __m512i alpha_span = _mm512_set1_epi8('z' - 'a');
+  const __m512i digit_base = _mm512_set1_epi8('0');
+  const __m512i digit_span = _mm512_set1_epi8('9' - '0');
+  const __m512i underscore = _mm512_set1_epi8('_');
+
+  while (begin + length != end)
+  {
+    __m512i v = _mm512_maskz_loadu_epi8(block_mask(end - (begin + length)), begin + length);
+    std::uint64_t is_symbol = _mm512_cmple_epu8_mask(_mm512_sub_epi8(_mm512_or_si512(v, lower), alpha_base), alpha_span) |
+        _mm512_cmple_epu8_mask(_mm512_sub_epi8(v, digit_base), digit_span) | _mm512_cmpeq_epi8_mask(v, underscore);
+
+    if (~is_symbol)
+    {
+      return length + static_cast<std::size_t>(std::countr_zero(~is_symbol));
+    }
+    length += 64;
+  }
+
+  return length;
+}
+#endif
+
+template <bool Padded = false>
+inline std::size_t scan_digits_scalar(const char* begin, const char* end, std::size_t length = 0) noexcept
+{
+  const char* it = begin + length;
+  while ((Padded || it != end) && is_digit(*it))
+  {
+    ++it;
+  }
+  return static_cast<std::size_t>(it - begin);
+}
+
+#if defined(LEXERTK_SIMD_DISPATCH)
+template <bool Padded = false>
+LEXERTK_TARGET_AVX2 inline std::size_t scan_digits_avx2(const char* begin, const char* end) noexcept
+{
+  std::size_t length = 0;
+  const __m256i digit_base = _mm256_set1_epi8('0');
+  const __m256i digit_span = _mm256_set1_epi8('9' - '0');
+
+  while (Padded || end - (begin + length) >= 32)
+  {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin + length));
+    __m256i digit = _mm256_sub_epi8(v, digit_base);
+    __m256i is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, digit_span), digit);
+
+    auto stop = ~static_cast<std::uint32_t>(_mm256_movemask_epi8(is_digit));
+    if (stop)
+    {
+      return length + static_cast<std::size_t>(std::countr_zero(stop));
+    }
+    length += 32;
+  }
+
+  return scan_digits_scalar<Padded>(begin, end, length);
+}
+
+template <bool Padded = false>
+LEXERTK_TARGET_SSE4_2 inline std::size_t scan_digits_sse4_2(const char* begin, const char* end) noexcept
+{
+  std::size_t length = 0;
+  const __m128i digit_base = _mm_set1_epi8('0');
+  const __m128i digit_span = _mm_set1_epi8('9' - '0');
+
+  while (Padded || end - (begin + length) >= 16)
+  {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin + length));
+    __m128i digit = _mm_sub_epi8(v, digit_base);
+    __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digit, digit_span), digit);
+
+    auto stop = static_cast<std::uint16_t>(~_mm_movemask_epi8(is_digit));
+    if (stop)
+    {
+      return length + static_cast<std::size_t>(std::countr_zero(stop));
+    }
+    length += 16;
+  }
+
+  return scan_digits_scalar<Padded>(begin, end, length);
+}
+
+LEXERTK_TARGET_AVX512 inline std::size_t scan_digits_avx512(const char* begin, const char* end) noexcept
+{
+  std::size_t length = 0;
+  const __m512i digit_base = _mm512_set1_epi8('0');
+  const __m512i digit_span = _mm512_set1_epi8('9' - '0');
+
+  while (begin + length != end)
+  {
+    __m512i v = _mm512_maskz_loadu_epi8(block_mask(end - (begin + length)), begin + length);
+    std::uint64_t is_digit = _mm512_cmple_epu8_mask(_mm512_sub_epi8(v, digit_base), digit_span);
+
+    if (~is_digit)
+    {
+      return length + static_cast<std::size_t>(std::countr_zero(~is_digit));
+    }
+    length += 64;
+  }
+
+  return length;
+}
+#endif
+
+struct string_run : text_run
+{
+  // length is the offset of the closing delimiter, or of end if the string is unterminated
+  bool escaped{false};
+};
+
+inline string_run scan_string_scalar(const char* begin, const char* end, string_run run = {}) noexcept
+{
+  const char* it = begin + run.length;
+  while (it != end && !is_string_delimiter(*it))
+  {
+    if (*it == '\\')
+    {
+      run.escaped = true;
+      if (++it == end)
+      {
+        break;
+      }
+    }
+    if (*it == '\n')
+    {
+      ++run.newlines;
+      run.line_start = static_cast<std::size_t>(it - begin) + 1;
+    }
+    ++it;
+  }
+  run.length = static_cast<std::size_t>(it - begin);
+  return run;
+}
+
+// Resolves the first special byte of a block: a delimiter ends the string,
+// a backslash swallows the byte after it. Returns true if the run is complete.
+template <typename Mask>
+bool resolve_string_block(const char* begin, const char* end, string_run& run, Mask special, Mask nl_mask) noexcept
+{
+  advance_run(run, nl_mask, std::countr_zero(special));
+  if (begin[run.length] != '\\')
+  {
+    return true;
+  }
+
+  run.escaped = true;
+  if (end - (begin + run.length) <= 2)
+  {
+    run = scan_string_scalar(begin, end, run);
+    return true;
+  }
+  else if (begin[run.length + 1] == '\n')
+  {
+    ++run.newlines;
+    run.line_start = run.length + 2;
+  }
+  run.length += 2;
+  return false;
+}
+
+#if defined(LEXERTK_SIMD_DISPATCH)
+LEXERTK_TARGET_AVX2 inline string_run scan_string_avx2(const char* begin, const char* end) noexcept
+{
+  string_run run;
+  const __m256i quote = _mm256_set1_epi8('\'');
+  const __m256i dquote = _mm256_set1_epi8('"');
+  const __m256i backslash = _mm256_set1_epi8('\\');
+  const __m256i newline = _mm256_set1_epi8('\n');
+
+  while (end - (begin + run.length) >= 32)
+  {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin + run.length));
+    __m256i delimiter = _mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, dquote));
+    auto special = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(delimiter, _mm256_cmpeq_epi8(v, backslash))));
+    auto nl_mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, newline)));
+
+    if (!special)
+    {
+      advance_run(run, nl_mask, 32);
+    }
+    else if (resolve_string_block(begin, end, run, special, nl_mask))
+    {
+      return run;
+    }
+  }
+
+  return scan_string_scalar(begin, end, run);
+}
+
+LEXERTK_TARGET_SSE4_2 inline string_run scan_string_sse4_2(const char* begin, const char* end) noexcept
+{
+  string_run run;
+  const __m128i quote = _mm_set1_epi8('\'');
+  const __m128i dquote = _mm_set1_epi8('"');
+  const __m128i backslash = _mm_set1_epi8('\\');
+  const __m128i newline = _mm_set1_epi8('\n');
+
+  while (end - (begin + run.length) >= 16)
+  {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin + run.length));
+    __m128i delimiter = _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, dquote));
+    auto special = static_cast<std::uint16_t>(_mm_movemask_epi8(_mm_or_si128(delimiter, _mm_cmpeq_epi8(v, backslash))));
+    auto nl_mask = static_cast<std::uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, newline)));
+
+    if (!special)
+    {
+      advance_run(run, nl_mask, 16);
+    }
+    else if (resolve_string_block(begin, end, run, special, nl_mask))
+    {
+      return run;
+    }
+  }
+
+  return scan_string_scalar(begin, end, run);
+}
+
+LEXERTK_TARGET_AVX512 inline string_run scan_string_avx512(const char* begin, const char* end) noexcept
+{
+  string_run run;
+  const __m512i quote = _mm512_set1_epi8('\'');
+  const __m512i dquote = _mm512_set1_epi8('"');
+  const __m512i backslash = _mm512_set1_epi8('\\');
+  const __m512i newline = _mm512_set1_epi8('\n');
+
+  while (begin + run.length != end)
+  {
+    auto remaining = end - (begin + run.length);
+    __m512i v = _mm512_maskz_loadu_epi8(block_mask(remaining), begin + run.length);
+    std::uint64_t special = _mm512_cmpeq_epi8_mask(v, quote) | _mm512_cmpeq_epi8_mask(v, dquote) | _mm512_cmpeq_epi8_mask(v, backslash);
+    std::uint64_t nl_mask = _mm512_cmpeq_epi8_mask(v, newline);
+
+    if (!special)
+    {
+      advance_run(run, nl_mask, static_cast<int>(std::min<std::ptrdiff_t>(remaining, 64)));
+    }
+    else if (resolve_string_block(begin, end, run, special, nl_mask))
+    {
+      return run;
+    }
+  }
+
+  return run;
+}
+#endif
+
+// Returns the offset of the first '\n' at or after begin, or end - begin.
+inline std::size_t find_newline(const char* begin, const char* end) noexcept
+{
+  // memchr is already vectorised (and runtime dispatched) by the C library
+  const void* nl = std::memchr(begin, '\n', static_cast<std::size_t>(end - begin));
+  return nl ? static_cast<std::size_t>(static_cast<const char*>(nl) - begin) : static_cast<std::size_t>(end - begin);
+}
+
+inline text_run scan_block_comment_scalar(const char* begin, const char* end, text_run run = {}) noexcept
+{
+  const char* it = begin + run.length;
+  while (it != end)
+  {
+    if (*it == '*' && it + 1 != end && it[1] == '/')
+    {
+      it += 2;
+      break;
+    }
+    else if (*it == '\n')
+    {
+      ++run.newlines;
+      run.line_start = static_cast<std::size_t>(it - begin) + 1;
+    }
+    ++it;
+  }
+  run.length = static_cast<std::size_t>(it - begin);
+  return run;
+}
+
+#if defined(LEXERTK_SIMD_DISPATCH)
+LEXERTK_TARGET_AVX2 inline text_run scan_block_comment_avx2(const char* begin, const char* end) noexcept
+{
+  text_run run;
+  const __m256i star = _mm256_set1_epi8('*');
+  const __m256i slash = _mm256_set1_epi8('/');
+  const __m256i newline = _mm256_set1_epi8('\n');
+
+  // the second load reads one byte ahead to pair every '*' with its successor
+  while (end - (begin + run.length) > 32)
+  {
+    const char* block = begin + run.length;
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+    __m256i next = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 1));
+    auto close = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(v, star), _mm256_cmpeq_epi8(next, slash))));
+    auto nl_mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, newline)));
+
+    if (close)
+    {
+      advance_run(run, nl_mask, std::countr_zero(close));
+      run.length += 2;
+      return run;
+    }
+    advance_run(run, nl_mask, 32);
+  }
+
+  return scan_block_comment_scalar(begin, end, run);
+}
+
+LEXERTK_TARGET_SSE4_2 inline text_run scan_block_comment_sse4_2(const char* begin, const char* end) noexcept
+{
+  text_run run;
+  const __m128i star = _mm_set1_epi8('*');
+  const __m128i slash = _mm_set1_epi8('/');
+  const __m128i newline = _mm_set1_epi8('\n');
+
+  while (end - (begin + run.length) > 16)
+  {
+    const char* block = begin + run.length;
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+    __m128i next = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 1));
+    auto close = static_cast<std::uint16_t>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(v, star), _mm_cmpeq_epi8(next, slash))));
+    auto nl_mask = static_cast<std::uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, newline)));
+
+    if (close)
+    {
+      advance_run(run, nl_mask, std::countr_zero(close));
+      run.length += 2;
+      return run;
+    }
+    advance_run(run, nl_mask, 16);
+  }
+
+  return scan_block_comment_scalar(begin, end, run);
+}
+
+LEXERTK_TARGET_AVX512 inline text_run scan_block_comment_avx512(const char* begin, const char* end) noexcept
+{
+  text_run run;
+  const __m512i star = _mm512_set1_epi8('*');
+  const __m512i slash = _mm512_set1_epi8('/');
+  const __m512i newline = _mm512_set1_epi8('\n');
+
+  while (begin + run.length != end)
+  {
+    const char* block = begin + run.length;
+    auto remaining = end - block;
+    __m512i v = _mm512_maskz_loadu_epi8(block_mask(remaining), block);
+    __m512i next = _mm512_maskz_loadu_epi8(block_mask(remaining - 1), block + 1);
+    std::uint64_t close = _mm512_cmpeq_epi8_mask(v, star) & _mm512_cmpeq_epi8_mask(next, slash);
+    std::uint64_t nl_mask = _mm512_cmpeq_epi8_mask(v, newline);
+
+    if (close)
+    {
+      advance_run(run, nl_mask, std::countr_zero(close));
+      run.length += 2;
+      return run;
+    }
+    advance_run(run, nl_mask, static_cast<int>(std::min<std::ptrdiff_t>(remaining, 64)));
+  }
+
+  return run;
+}
+#endif
+
+// Copies the bytes from begin up to the first backslash or end to out and
+// returns their number. The vector kernels store whole blocks, out must have
+// room for end - begin bytes and must not overlap the input.
+inline std::size_t copy_unescaped_scalar(const char* begin, const char* end, char* out) noexcept
+{
+  const void* backslash = std::memchr(begin, '\\', static_cast<std::size_t>(end - begin));
+  auto length = backslash ? static_cast<std::size_t>(static_cast<const char*>(backslash) - begin) : static_cast<std::size_t>(end - begin);
+  std::memcpy(out, begin, length);
+  return length;
+}
+
+#if defined(LEXERTK_SIMD_DISPATCH)
+LEXERTK_TARGET_AVX2 inline std::size_t copy_unescaped_avx2(const char* begin, const char* end, char* out) noexcept
+{
+  const __m256i backslash = _mm256_set1_epi8('\\');
+
+  std::size_t length = 0;
+  for (; end - (begin + length) >= 32; length += 32)
+  {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin + length));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + length), v);
+    if (auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, backslash))))
+    {
+      return length + static_cast<std::size_t>(std::countr_zero(mask));
+    }
+  }
+
+  return length + copy_unescaped_scalar(begin + length, end, out + length);
+}
+
+LEXERTK_TARGET_SSE4_2 inline std::size_t copy_unescaped_sse4_2(const char* begin, const char* end, char* out) noexcept
+{
+  const __m128i backslash = _mm_set1_epi8('\\');
+
+  std::size_t length = 0;
+  for (; end - (begin + length) >= 16; length += 16)
+  {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin + length));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + length), v);
+    if (auto mask = static_cast<std::uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, backslash))))
+    {
+      return length + static_cast<std::size_t>(std::countr_zero(mask));
+    }
+  }
+
+  return length + copy_unescaped_scalar(begin + length, end, out + length);
+}
+
+LEXERTK_TARGET_AVX512 inline std::size_t copy_unescaped_avx512(const char* begin, const char* end, char* out) noexcept
+{
+  const __m512i backslash = _mm512_set1_epi8('\\');
+
+  std::size_t length = 0;
+  while (begin + length != end)
+  {
+    auto remaining = end - (begin + length);
+    auto mask = block_mask(remaining);
+    __m512i v = _mm512_maskz_loadu_epi8(mask, begin + length);
+    _mm512_mask_storeu_epi8(out + length, mask, v);
+    if (std::uint64_t found = _mm512_mask_cmpeq_epi8_mask(mask, v, backslash))
+    {
+      return length + static_cast<std::size_t>(std::countr_zero(found));
+    }
+    length += static_cast<std::size_t>(std::min<std::ptrdiff_t>(remaining, 64));
+  }
+
+  return length;
+}
+#endif
+
+// Entry points of the kernels of one instruction set level. The kernels whose
+// runs stop at a zero byte come in two flavours, indexed by whether the input
+// is padded, see padded_input.
+struct kernel_table
+{
+  template <typename Run>
+  using kernel = Run (*)(const char*, const char*) noexcept;
+  using copy_kernel = std::size_t (*)(const char*, const char*, char*) noexcept;
+
+  isa_level level{isa_level::scalar};
+  std::array<kernel<text_run>, 2> scan_whitespace;
+  std::array<kernel<std::size_t>, 2> scan_symbol;
+  std::array<kernel<std::size_t>, 2> scan_digits;
+  kernel<string_run> scan_string;
+  kernel<text_run> scan_block_comment;
+  copy_kernel copy_unescaped;
+};
+
+inline kernel_table kernels_for(isa_level level) noexcept
+{
+  switch (level)
+  {
+#if defined(LEXERTK_SIMD_DISPATCH)
+    case isa_level::avx512:
+      // the masked tail loads never read past the end anyway
+      return {level, {scan_whitespace_avx512, scan_whitespace_avx512}, {scan_symbol_avx512, scan_symbol_avx512}, {scan_digits_avx512, scan_digits_avx512},
+          scan_string_avx512, scan_block_comment_avx512, copy_unescaped_avx512};
+    case isa_level::avx2:
+      return {level, {scan_whitespace_avx2<false>, scan_whitespace_avx2<true>}, {scan_symbol_avx2<false>, scan_symbol_avx2<true>},
+          {scan_digits_avx2<false>, scan_digits_avx2<true>}, scan_string_avx2, scan_block_comment_avx2, copy_unescaped_avx2};
+    case isa_level::sse4_2:
+      return {level, {scan_whitespace_sse4_2<false>, scan_whitespace_sse4_2<true>}, {scan_symbol_sse4_2<false>, scan_symbol_sse4_2<true>},
+          {scan_digits_sse4_2<false>, scan_digits_sse4_2<true>}, scan_string_sse4_2, scan_block_comment_sse4_2, copy_unescaped_sse4_2};
+#endif
+    default:
+      return {isa_level::scalar,
+          {[](const char* begin, const char* end) noexcept { return scan_whitespace_scalar<false>(begin, end); },
+              [](const char* begin, const char* end) noexcept { return scan_whitespace_scalar<true>(begin, end); }},
+          {[](const char* begin, const char* end) noexcept { return scan_symbol_scalar<false>(begin, end); },
+              [](const char* begin, const char* end) noexcept { return scan_symbol_scalar<true>(begin, end); }},
+          {[](const char* begin, const char* end) noexcept { return scan_digits_scalar<false>(begin, end); },
+              [](const char* begin, const char* end) noexcept { return scan_digits_scalar<true>(begin, end); }},
+          [](const char* begin, const char* end) noexcept { return scan_string_scalar(begin, end); },
+          [](const char* begin, const char* end) noexcept { return scan_block_comment_scalar(begin, end); }, copy_unescaped_scalar};
+  }
+}
+
+// The kernels in use, selected from the detected CPU features on first use.
+inline kernel_table& active_kernels() noexcept
+{
+  static kernel_table kernels = kernels_for(detected_isa_level());
+  return kernels;
+}
+
+// Measures the whitespace run starting at begin and counts the newlines in it.
+// With Padded the input must be followed by padded_input::padding zero bytes.
+template <bool Padded = false>
+inline text_run scan_whitespace(const char* begin, const char* end) noexcept
+{
+  if ((!Padded && begin == end) || !is_whitespace(*begin))
+  {
+    return {};
+  }
+  // most whitespace runs between tokens are a single blank
+  else if ((!Padded && begin + 1 == end) || !is_whitespace(begin[1]))
+  {
+    return {1, *begin == '\n' ? 1u : 0u, 1};
+  }
+
+  return active_kernels().scan_whitespace[Padded](begin, end);
+}
+
+// Returns the length of the run of [A-Za-z0-9_] starting at begin.
+template <bool Padded = false>
+inline std::size_t scan_symbol(const char* begin, const char* end) noexcept
+{
+  return active_kernels().scan_symbol[Padded](begin, end);
+}
+
+// Returns the length of the run of [0-9] starting at begin.
+template <bool Padded = false>
+inline std::size_t scan_digits(const char* begin, const char* end) noexcept
+{
+  // the run after a '.', 'e' or sign is often empty or a single digit
+  if ((!Padded && begin == end) || !is_digit(*begin))
+  {
+    return 0;
+  }
+  else if ((!Padded && begin + 1 == end) || !is_digit(begin[1]))
+  {
+    return 1;
+  }
+
+  return active_kernels().scan_digits[Padded](begin, end);
+}
+
+// Finds the first unescaped string delimiter at or after begin.
+inline string_run scan_string(const char* begin, const char* end) noexcept
+{
+  return active_kernels().scan_string(begin, end);
+}
+
+// Measures a block comment body up to and including the closing "*/", or up
+// to end if it is unterminated, and counts the newlines inside it.
+inline text_run scan_block_comment(const char* begin, const char* end) noexcept
+{
+  return active_kernels().scan_block_comment(begin, end);
+}
+
+// Copies the bytes up to the first backslash, see copy_unescaped_scalar.
+inline std::size_t copy_unescaped(const char* begin, const char* end, char* out) noexcept
+{
+  return active_kernels().copy_unescaped(begin, end, out);
+}
+}  // namespace simd
+}  // namespace details
+
+// The level the scanner kernels currently run at.
+inline isa_level active_isa_level() noexcept
+{
+  return details::simd::active_kernels().level;
+}
+
+// Switches the scanner kernels to the given level, e.g. to exercise the
+// narrower paths on a wide machine. Levels the CPU lacks are lowered to
+// detected_isa_level(). Must not race with lexing on other threads.
+// Returns the level now in effect.
+inline isa_level force_isa_level(isa_level level) noexcept
+{
+  details::simd::active_kernels() = details::simd::kernels_for(std::min(level, detected_isa_level()));
+  return active_isa_level();
+}
+}  // namespace lexertk
+
+#endif  //LEXERTK_SIMD_HPP
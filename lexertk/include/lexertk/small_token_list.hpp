@@ -0,0 +1,98 @@
+//
+// Created by allspark on 17/10/2026.
+//
+
+#ifndef LEXERTK_SMALL_TOKEN_LIST_HPP
+#define LEXERTK_SMALL_TOKEN_LIST_HPP
+
+#include "token.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+
+namespace lexertk
+{
+// Token list keeping the first InlineCapacity tokens inside the object and
+// only going to the heap, through Allocator, once more are added. Lexing a
+// short expression into it does not allocate. Otherwise it behaves like a
+// std::vector<Token, Allocator>, the iterators are plain pointers and are
+// invalidated by growing.
+template <typename Token, std::size_t InlineCapacity, typename Allocator = std::allocator<Token>>
+class basic_small_token_list
+{
+  static_assert(std::is_trivially_copyable_v<Token>, "tokens are relocated with memcpy");
+  static_assert(InlineCapacity > 0);
+
+public:
+  using value_type = Token;
+  using size_type = std::size_t;
+  using allocator_type = Allocator;
+  using iterator = Token*;
+  using const_iterator = Token const*;
+
+  static constexpr std::size_t inline_capacity = InlineCapacity;
+
+  // user provided, value initialization must not zero the inline buffer
+  inline basic_small_token_list() noexcept;
+  inline explicit basic_small_token_list(Allocator const& allocator) noexcept;
+  // Like std::vector the allocator is copied on construction and kept on
+  // assignment, so a list assigned from one with an unequal allocator copies.
+  inline basic_small_token_list(basic_small_token_list const& other);
+  inline basic_small_token_list(basic_small_token_list&& other) noexcept;
+  inline basic_small_token_list& operator=(basic_small_token_list const& other);
+  inline basic_small_token_list& operator=(basic_small_token_list&& other) noexcept(is_always_equal);
+  inline ~basic_small_token_list();
+
+  inline void reserve(std::size_t count);
+  template <typename... Args>
+  inline Token& emplace_back(Args&&... args);
+  inline void push_back(Token const& t);
+  inline void pop_back() noexcept;
+  inline void clear() noexcept;
+
+  inline std::size_t size() const noexcept;
+  inline std::size_t capacity() const noexcept;
+  inline bool empty() const noexcept;
+  inline Allocator get_allocator() const noexcept;
+  // true while the tokens live in the inline buffer
+  inline bool is_inline() const noexcept;
+
+  inline iterator begin() noexcept;
+  inline iterator end() noexcept;
+  inline const_iterator begin() const noexcept;
+  inline const_iterator end() const noexcept;
+  inline Token& operator[](std::size_t i) noexcept;
+  inline Token const& operator[](std::size_t i) const noexcept;
+  inline Token& back() noexcept;
+  inline Token const& back() const noexcept;
+
+private:
+  static constexpr bool is_always_equal = std::allocator_traits<Allocator>::is_always_equal::value;
+
+  inline Token* inline_data() noexcept;
+  inline void grow(std::size_t count);
+  // copies the tokens of other, keeping the allocator of this list
+  inline void assign(basic_small_token_list const& other);
+  // moves the tokens of other into this empty list, other's buffer must
+  // belong to an allocator equal to this list's
+  inline void take(basic_small_token_list& other) noexcept;
+  // frees the heap buffer, if any
+  inline void release() noexcept;
+
+  [[no_unique_address]] Allocator m_allocator{};
+  Token* m_data{inline_data()};
+  std::size_t m_size{0};
+  std::size_t m_capacity{InlineCapacity};
+  alignas(Token) std::byte m_inline[InlineCapacity * sizeof(Token)];
+};
+
+// 64 tokens inline, enough for most expressions, and a memory_resource for
+// longer ones
+using small_token_list = basic_small_token_list<token, 64, std::pmr::polymorphic_allocator<token>>;
+}  // namespace lexertk
+
+#include "small_token_list.ipp"
+
+#endif  //LEXERTK_SMALL_TOKEN_LIST_HPP
@@ -0,0 +1,249 @@
+//
+// Created by allspark on 17/10/2026.
+//
+
+#ifndef LEXERTK_SMALL_TOKEN_LIST_IPP
+#define LEXERTK_SMALL_TOKEN_LIST_IPP
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <utility>
+
+namespace lexertk
+{
+template <typename Token, std::size_t InlineCapacity, typename Allocator>
+basic_small_token_list<Token, InlineCapacity, Allocator>::basic_small_token_list() noexcept
+{
+}
+
+template <typename Token, std::size_t InlineCapacity, typename Allocator>
+basic_small_token_list<Token, InlineCapacity, Allocator>::basic_small_token_list(Allocator const& allocator) noexcept
+  : m_allocator{allocator}
+{
+}
+
+template <typename Token, std::size_t InlineCapacity, typename Allocator>
+basic_small_token_list<Token, InlineCapacity, Allocator>::basic_small_token_list(basic_small_token_list const& other)
+  : m_allocator{std::allocator_traits<Allocator>::select_on_container_copy_construction(other.m_allocator)}
+{
+  assign(other);
+}
+
+template <typename Token, std::size_t InlineCapacity, typename Allocator>
+basic_small_token_list<Token, InlineCapacity, Allocator>::basic_small_token_list(basic_small_token_list&& other) noexcept
+  : m_allocator{other.m_allocator}
+{
+  take(other);
+}
+
+template <typename Token, std::size_t InlineCapacity, typename Allocator>
+basic_small_token_list<Token, InlineCapacity, Allocator>& basic_small_token_list<Token, InlineCapacity, Allocator>::operator=(basic_small_token_list const& other)
+{
+  if (this != &other)
+  {
+    assign(other);
+  }
+  return *this;
+}
+
+template <typename Token, std::size_t InlineCapacity, typename Allocator>
+basic_small_token_list<Token, InlineCapacity, Allocator>& basic_small_token_list<Token, InlineCapacity, Allocator>::operator=(basic_small_token_list&& other) noexcept(is_always_equal)
+{
+  if (this == &other)
+  {
+    return *this;
+  }
+
+  // the heap buffer of other can only be taken if it was allocated by an
+  // allocator equal to the one this list keeps
+  if constexpr (!is_always_equal)
+  {
+    if (m_allocator != other.m_allocator)
+    {
+      assign(other);
+      other.clear();
+      return *this;
+    }
+  }
+  release();
+  take(other);
+  return *this;
+}
+
+template <typename Token, std::size_t InlineCapacity, typename Allocator>
+basic_small_token_list<Token, InlineCapacity, Allocator>::~basic_small_token_list()
+{
+  release();
+}
+
+template <typename Token, std::size_t InlineCapacity, typename Allocator>
+void basic_small_token_list<Token, InlineCapacity, Allocator>::reserve(std::size_t count)
+{
+  if (count > m_capacity)
+  {
+    grow(count);
+  }
+}
+
+template <typename Token, std::size_t InlineCapacity, typename Allocator>
+template <typename... Args>
+Token& basic_small_token_list<Token, InlineCapacity, Allocator>::emplace_back(Args&&... args)
+{
+  if (m_size == m_capacity)
+  {
+    grow(2 * m_capacity);
+  }
+  return *std::construct_at(m_data + m_size++, std::forward<Args>(args)...);
+}
+
+template <typename Token, std::size_t InlineCapacity, typename Allocator>
+void basic_small_token_list<Token, InlineCapacity, Allocator>::push_back(Token const& t)
+{
+  emplace_back(t);
+}
+
+template <typename Token, std::size_t InlineCapacity, typename Allocator>
+void basic_small_token_list<Token, InlineCapacity, Allocator>::pop_back() noexcept
+{
+  --m_size;
+}
+
+template <typename Token, std::size_t InlineCapacity, typename Allocator>
+void basic_small_token_list<Token, InlineCapacity, Allocator>::clear() noexcept
+{
+  m_size = 0;
+}
+
+template <typename Token, std::size_t InlineCapacity, typename Allocator>
+std::size_t basic_small_token_list<Token, InlineCapacity, Allocator>::size() const noexcept
+{
+  return m_size;
+}
+
+template <typename Token, std::size_t InlineCapacity, typename Allocator>
+std::size_t basic_small_token_list<Token, InlineCapacity, Allocator>::capacity() const noexcept
+{
+  return m_capacity;
+}
+
+template <typename Token, std::size_t InlineCapacity, typename Allocator>
+bool basic_small_token_list<Token, InlineCapacity, Allocator>::empty() const noexcept
+{
+  return m_size == 0;
+}
+
+template <typename Token, std::size_t InlineCapacity, typename Allocator>
+Allocator basic_small_token_list<Token, InlineCapacity, Allocator>::get_allocator() const noexcept
+{
+  return m_allocator;
+}
+
+template <typename Token, std::size_t InlineCapacity, typename Allocator>
+bool basic_small_token_list<Token, InlineCapacity, Allocator>::is_inline() const noexcept
+{
+  return m_data == reinterpret_cast<Token const*>(m_inline);
+}
+
+template <typename Token, std::size_t InlineCapacity, typename Allocator>
+typename basic_small_token_list<Token, InlineCapacity, Allocator>::iterator basic_small_token_list<Token, InlineCapacity, Allocator>::begin() noexcept
+{
+  return m_data;
+}
+
+template <typename Token, std::size_t InlineCapacity, typename Allocator>
+typename basic_small_token_list<Token, InlineCapacity, Allocator>::iterator basic_small_token_list<Token, InlineCapacity, Allocator>::end() noexcept
+{
+  return m_data + m_size;
+}
+
+template <typename Token, std::size_t InlineCapacity, typename Allocator>
+typename basic_small_token_list<Token, InlineCapacity, Allocator>::const_iterator basic_small_token_list<Token, InlineCapacity, Allocator>::begin() const noexcept
+{
+  return m_data;
+}
+
+template <typename Token, std::size_t InlineCapacity, typename Allocator>
+typename basic_small_token_list<Token, InlineCapacity, Allocator>::const_iterator basic_small_token_list<Token, InlineCapacity, Allocator>::end() const noexcept
+{
+  return m_data + m_size;
+}
+
+template <typename Token, std::size_t InlineCapacity, typename Allocator>
+Token& basic_small_token_list<Token, InlineCapacity, Allocator>::operator[](std::size_t i) noexcept
+{
+  return m_data[i];
+}
+
+template <typename Token, std::size_t InlineCapacity, typename Allocator>
+Token const& basic_small_token_list<Token, InlineCapacity, Allocator>::operator[](std::size_t i) const noexcept
+{
+  return m_data[i];
+}
+
+template <typename Token, std::size_t InlineCapacity, typename Allocator>
+Token& basic_small_token_list<Token, InlineCapacity, Allocator>::back() noexcept
+{
+  return m_data[m_size - 1];
+}
+
+template <typename Token, std::size_t InlineCapacity, typename Allocator>
+Token const& basic_small_token_list<Token, InlineCapacity, Allocator>::back() const noexcept
+{
+  return m_data[m_size - 1];
+}
+
+template <typename Token, std::size_t InlineCapacity, typename Allocator>
+Token* basic_small_token_list<Token, InlineCapacity, Allocator>::inline_data() noexcept
+{
+  return reinterpret_cast<Token*>(m_inline);
+}
+
+template <typename Token, std::size_t InlineCapacity, typename Allocator>
+void basic_small_token_list<Token, InlineCapacity, Allocator>::grow(std::size_t count)
+{
+  Token* data = std::allocator_traits<Allocator>::allocate(m_allocator, count);
+  std::memcpy(static_cast<void*>(data), m_data, m_size * sizeof(Token));
+  release();
+  m_data = data;
+  m_capacity = count;
+}
+
+template <typename Token, std::size_t InlineCapacity, typename Allocator>
+void basic_small_token_list<Token, InlineCapacity, Allocator>::assign(basic_small_token_list const& other)
+{
+  m_size = 0;
+  reserve(other.m_size);
+  std::memcpy(static_cast<void*>(m_data), other.m_data, other.m_size * sizeof(Token));
+  m_size = other.m_size;
+}
+
+template <typename Token, std::size_t InlineCapacity, typename Allocator>
+void basic_small_token_list<Token, InlineCapacity, Allocator>::take(basic_small_token_list& other) noexcept
+{
+  if (other.is_inline())
+  {
+    // only the tokens in use are copied
+    m_data = inline_data();
+    m_capacity = InlineCapacity;
+    std::memcpy(static_cast<void*>(m_data), other.m_data, other.m_size * sizeof(Token));
+  }
+  else
+  {
+    m_data = std::exchange(other.m_data, other.inline_data());
+    m_capacity = std::exchange(other.m_capacity, InlineCapacity);
+  }
+  m_size = std::exchange(other.m_size, 0);
+}
+
+template <typename Token, std::size_t InlineCapacity, typename Allocator>
+void basic_small_token_list<Token, InlineCapacity, Allocator>::release() noexcept
+{
+  if (!is_inline())
+  {
+    std::allocator_traits<Allocator>::deallocate(m_allocator, m_data, m_capacity);
+  }
+}
+}  // namespace lexertk
+
+#endif  //LEXERTK_SMALL_TOKEN_LIST_IPP
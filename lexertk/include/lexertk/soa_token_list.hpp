@@ -0,0 +1,162 @@
+//
+// Created by allspark on 16/10/2026.
+//
+
+#ifndef LEXERTK_SOA_TOKEN_LIST_HPP
+#define LEXERTK_SOA_TOKEN_LIST_HPP
+
+#include "source_map.hpp"
+#include "token.hpp"
+#include "token_list.hpp"
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace lexertk
+{
+// Token list storing each token field in an array of its own, so a pass that
+// only looks at types runs over one dense byte per token. Element access and
+// iteration assemble token objects for code written against std::vector<token>.
+// Offsets are resolved through a source_map, the inputs must stay alive.
+class soa_token_list
+{
+public:
+  using iterator = std::string_view::const_iterator;
+  using value_type = token;
+  class const_iterator;
+
+  soa_token_list() = default;
+
+  // Starts a new input, tokens emplaced after it must lie inside it.
+  inline void add_source(std::string_view text);
+
+  inline void reserve(std::size_t count);
+  inline void emplace_back(token::token_type type, iterator begin, iterator end, token::Position position);
+  inline void clear() noexcept;
+
+  inline std::size_t size() const noexcept;
+  inline std::size_t capacity() const noexcept;
+  inline bool empty() const noexcept;
+  inline const_iterator begin() const noexcept;
+  inline const_iterator end() const noexcept;
+  inline token operator[](std::size_t i) const noexcept;
+  inline token back() const noexcept;
+
+  // Copies the list into the layout the helpers work on.
+  inline token_list to_tokens(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const;
+
+  // The columns, index i of each belongs to token i.
+  inline std::span<const token::token_type> types() const noexcept;
+  inline std::span<const std::uint32_t> offsets() const noexcept;
+  inline std::span<const std::uint32_t> lengths() const noexcept;
+  inline std::span<const token::Position> positions() const noexcept;
+
+  inline const char* location_of(std::size_t i) const noexcept;
+  inline std::string_view value_of(std::size_t i) const noexcept;
+
+private:
+  std::vector<token::token_type> m_types;
+  std::vector<std::uint32_t> m_offsets;
+  std::vector<std::uint32_t> m_lengths;
+  std::vector<token::Position> m_positions;
+  source_map m_sources;
+};
+
+// Random access iterator yielding token objects by value.
+class soa_token_list::const_iterator
+{
+public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = token;
+  using difference_type = std::ptrdiff_t;
+  using reference = token;
+  using pointer = void;
+
+  const_iterator() = default;
+  const_iterator(soa_token_list const* list, std::size_t index) noexcept
+    : m_list{list}
+    , m_index{index}
+  {
+  }
+
+  token operator*() const noexcept
+  {
+    return (*m_list)[m_index];
+  }
+  token operator[](difference_type n) const noexcept
+  {
+    return (*m_list)[m_index + static_cast<std::size_t>(n)];
+  }
+
+  const_iterator& operator++() noexcept
+  {
+    ++m_index;
+    return *this;
+  }
+  const_iterator operator++(int) noexcept
+  {
+    auto tmp = *this;
+    ++m_index;
+    return tmp;
+  }
+  const_iterator& operator--() noexcept
+  {
+    --m_index;
+    return *this;
+  }
+  const_iterator operator--(int) noexcept
+  {
+    auto tmp = *this;
+    --m_index;
+    return tmp;
+  }
+  const_iterator& operator+=(difference_type n) noexcept
+  {
+    m_index += static_cast<std::size_t>(n);
+    return *this;
+  }
+  const_iterator& operator-=(difference_type n) noexcept
+  {
+    m_index -= static_cast<std::size_t>(n);
+    return *this;
+  }
+
+  friend const_iterator operator+(const_iterator it, difference_type n) noexcept
+  {
+    return it += n;
+  }
+  friend const_iterator operator+(difference_type n, const_iterator it) noexcept
+  {
+    return it += n;
+  }
+  friend const_iterator operator-(const_iterator it, difference_type n) noexcept
+  {
+    return it -= n;
+  }
+  friend difference_type operator-(const_iterator const& a, const_iterator const& b) noexcept
+  {
+    return static_cast<difference_type>(a.m_index) - static_cast<difference_type>(b.m_index);
+  }
+  friend bool operator==(const_iterator const& a, const_iterator const& b) noexcept
+  {
+    return a.m_index == b.m_index;
+  }
+  friend std::strong_ordering operator<=>(const_iterator const& a, const_iterator const& b) noexcept
+  {
+    return a.m_index <=> b.m_index;
+  }
+
+private:
+  soa_token_list const* m_list{nullptr};
+  std::size_t m_index{0};
+};
+}  // namespace lexertk
+
+#include "soa_token_list.ipp"
+
+#endif  //LEXERTK_SOA_TOKEN_LIST_HPP
@@ -0,0 +1,113 @@
+//
+// Created by allspark on 16/10/2026.
+//
+
+#ifndef LEXERTK_SOA_TOKEN_LIST_IPP
+#define LEXERTK_SOA_TOKEN_LIST_IPP
+
+#include <memory>
+
+namespace lexertk
+{
+void soa_token_list::add_source(std::string_view text)
+{
+  m_sources.add(text);
+}
+
+void soa_token_list::reserve(std::size_t count)
+{
+  m_types.reserve(count);
+  m_offsets.reserve(count);
+  m_lengths.reserve(count);
+  m_positions.reserve(count);
+}
+
+void soa_token_list::emplace_back(token::token_type type, iterator begin, iterator end, token::Position position)
+{
+  m_types.push_back(type);
+  m_offsets.push_back(m_sources.offset_of(std::to_address(begin)));
+  m_lengths.push_back(static_cast<std::uint32_t>(std::distance(begin, end)));
+  m_positions.push_back(position);
+}
+
+void soa_token_list::clear() noexcept
+{
+  m_types.clear();
+  m_offsets.clear();
+  m_lengths.clear();
+  m_positions.clear();
+  m_sources.clear();
+}
+
+std::size_t soa_token_list::size() const noexcept
+{
+  return m_types.size();
+}
+
+std::size_t soa_token_list::capacity() const noexcept
+{
+  return m_types.capacity();
+}
+
+bool soa_token_list::empty() const noexcept
+{
+  return m_types.empty();
+}
+
+soa_token_list::const_iterator soa_token_list::begin() const noexcept
+{
+  return {this, 0};
+}
+
+soa_token_list::const_iterator soa_token_list::end() const noexcept
+{
+  return {this, size()};
+}
+
+token soa_token_list::operator[](std::size_t i) const noexcept
+{
+  return {m_types[i], value_of(i), m_positions[i]};
+}
+
+token soa_token_list::back() const noexcept
+{
+  return (*this)[size() - 1];
+}
+
+token_list soa_token_list::to_tokens(std::pmr::memory_resource* resource) const
+{
+  return {begin(), end(), resource};
+}
+
+std::span<const token::token_type> soa_token_list::types() const noexcept
+{
+  return m_types;
+}
+
+std::span<const std::uint32_t> soa_token_list::offsets() const noexcept
+{
+  return m_offsets;
+}
+
+std::span<const std::uint32_t> soa_token_list::lengths() const noexcept
+{
+  return m_lengths;
+}
+
+std::span<const token::Position> soa_token_list::positions() const noexcept
+{
+  return m_positions;
+}
+
+const char* soa_token_list::location_of(std::size_t i) const noexcept
+{
+  return m_sources.location_of(m_offsets[i]);
+}
+
+std::string_view soa_token_list::value_of(std::size_t i) const noexcept
+{
+  return {location_of(i), m_lengths[i]};
+}
+}  // namespace lexertk
+
+#endif  //LEXERTK_SOA_TOKEN_LIST_IPP
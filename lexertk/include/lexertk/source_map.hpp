@@ -0,0 +1,49 @@
+//
+// Created by allspark on 16/10/2026.
+//
+
+#ifndef LEXERTK_SOURCE_MAP_HPP
+#define LEXERTK_SOURCE_MAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace lexertk
+{
+// Numbers the bytes of all inputs lexed into one token list with 32 bit
+// offsets, which run on from one input to the next, and maps them back to
+// the inputs. One past the end of every input has an offset of its own, the
+// one of its eol token. The inputs must stay alive while offsets are mapped.
+class source_map
+{
+public:
+  source_map() = default;
+
+  // Starts a new input, the current one until the next call. Throws
+  // std::length_error once all inputs exceed 4 GiB.
+  inline void add(std::string_view text);
+  inline void clear() noexcept;
+
+  // Offset of a location inside the current input.
+  inline std::uint32_t offset_of(const char* location) const noexcept;
+  inline const char* location_of(std::uint32_t offset) const noexcept;
+
+private:
+  struct source
+  {
+    std::uint64_t offset;
+    const char* begin;
+    std::size_t size;
+  };
+
+  inline source const& source_of(std::uint32_t offset) const noexcept;
+
+  std::vector<source> m_sources;
+};
+}  // namespace lexertk
+
+#include "source_map.ipp"
+
+#endif  //LEXERTK_SOURCE_MAP_HPP
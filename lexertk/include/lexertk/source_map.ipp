@@ -0,0 +1,56 @@
+//
+// Created by allspark on 16/10/2026.
+//
+
+#ifndef LEXERTK_SOURCE_MAP_IPP
+#define LEXERTK_SOURCE_MAP_IPP
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+
+namespace lexertk
+{
+void source_map::add(std::string_view text)
+{
+  std::uint64_t offset = m_sources.empty() ? 0 : m_sources.back().offset + m_sources.back().size + 1;
+  if (offset + text.size() > std::numeric_limits<std::uint32_t>::max())
+  {
+    throw std::length_error("source_map: more than 4 GiB of input");
+  }
+
+  m_sources.push_back({offset, text.data(), text.size()});
+}
+
+void source_map::clear() noexcept
+{
+  m_sources.clear();
+}
+
+std::uint32_t source_map::offset_of(const char* location) const noexcept
+{
+  auto const& current = m_sources.back();
+  return static_cast<std::uint32_t>(current.offset + static_cast<std::uint64_t>(location - current.begin));
+}
+
+const char* source_map::location_of(std::uint32_t offset) const noexcept
+{
+  auto const& s = source_of(offset);
+  return s.begin + (offset - s.offset);
+}
+
+source_map::source const& source_map::source_of(std::uint32_t offset) const noexcept
+{
+  // a single input is the common case
+  if (m_sources.size() == 1)
+  {
+    return m_sources.front();
+  }
+
+  auto it = std::upper_bound(m_sources.begin(), m_sources.end(), offset, [](std::uint64_t o, source const& s) { return o < s.offset; });
+  return *std::prev(it);
+}
+}  // namespace lexertk
+
+#endif  //LEXERTK_SOURCE_MAP_IPP
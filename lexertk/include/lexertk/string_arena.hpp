@@ -0,0 +1,67 @@
+//
+// Created by allspark on 17/10/2026.
+//
+
+#ifndef LEXERTK_STRING_ARENA_HPP
+#define LEXERTK_STRING_ARENA_HPP
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+namespace lexertk
+{
+// Bump allocator for bytes that live until the arena is cleared or destroyed.
+// Memory is handed out from blocks of the memory_resource that never move,
+// not even when the arena is moved, so views into it stay valid while more is
+// allocated. clear() keeps the blocks for reuse.
+class string_arena
+{
+public:
+  static constexpr std::size_t block_size = 4096;
+
+  string_arena() noexcept
+    : string_arena(std::pmr::get_default_resource())
+  {
+  }
+  inline explicit string_arena(std::pmr::memory_resource* resource) noexcept;
+  string_arena(string_arena const&) = delete;
+  inline string_arena(string_arena&& other) noexcept;
+  string_arena& operator=(string_arena const&) = delete;
+  // Takes the blocks of other together with the resource they came from.
+  inline string_arena& operator=(string_arena&& other) noexcept;
+  inline ~string_arena();
+
+  // Uninitialized room for size bytes.
+  inline char* allocate(std::size_t size);
+  // Hands the last size bytes of the most recent allocation back.
+  inline void release_tail(std::size_t size) noexcept;
+  inline void clear() noexcept;
+
+  // Bytes handed out since the last clear().
+  inline std::size_t size() const noexcept;
+  // Whether location lies in memory of this arena.
+  inline bool owns(const char* location) const noexcept;
+
+private:
+  struct block
+  {
+    char* data;
+    std::size_t size;
+  };
+
+  inline void release() noexcept;
+
+  std::pmr::memory_resource* m_resource;
+  std::vector<block> m_blocks;
+  // the block allocations are taken from and the bytes used of it
+  std::size_t m_current{0};
+  std::size_t m_used{0};
+  // bytes used of the blocks before m_current
+  std::size_t m_filled{0};
+};
+}  // namespace lexertk
+
+#include "string_arena.ipp"
+
+#endif  //LEXERTK_STRING_ARENA_HPP
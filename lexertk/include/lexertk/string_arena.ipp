@@ -0,0 +1,107 @@
+//
+// Created by allspark on 17/10/2026.
+//
+
+#ifndef LEXERTK_STRING_ARENA_IPP
+#define LEXERTK_STRING_ARENA_IPP
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+namespace lexertk
+{
+string_arena::string_arena(std::pmr::memory_resource* resource) noexcept
+  : m_resource{resource}
+{
+}
+
+string_arena::string_arena(string_arena&& other) noexcept
+  : m_resource{other.m_resource}
+  , m_blocks{std::move(other.m_blocks)}
+  , m_current{std::exchange(other.m_current, 0)}
+  , m_used{std::exchange(other.m_used, 0)}
+  , m_filled{std::exchange(other.m_filled, 0)}
+{
+  other.m_blocks.clear();
+}
+
+string_arena& string_arena::operator=(string_arena&& other) noexcept
+{
+  if (this != &other)
+  {
+    release();
+    m_resource = other.m_resource;
+    m_blocks = std::move(other.m_blocks);
+    other.m_blocks.clear();
+    m_current = std::exchange(other.m_current, 0);
+    m_used = std::exchange(other.m_used, 0);
+    m_filled = std::exchange(other.m_filled, 0);
+  }
+  return *this;
+}
+
+string_arena::~string_arena()
+{
+  release();
+}
+
+char* string_arena::allocate(std::size_t size)
+{
+  // blocks too small for a large allocation are skipped until the next clear()
+  while (m_current < m_blocks.size() && m_blocks[m_current].size - m_used < size)
+  {
+    m_filled += m_used;
+    ++m_current;
+    m_used = 0;
+  }
+  if (m_current == m_blocks.size())
+  {
+    auto block_bytes = std::max(block_size, size);
+    // room first, a block must not be lost to a failing push_back
+    if (m_blocks.size() == m_blocks.capacity())
+    {
+      m_blocks.reserve(std::max<std::size_t>(4, 2 * m_blocks.size()));
+    }
+    m_blocks.push_back({static_cast<char*>(m_resource->allocate(block_bytes, 1)), block_bytes});
+  }
+
+  char* p = m_blocks[m_current].data + m_used;
+  m_used += size;
+  return p;
+}
+
+void string_arena::release_tail(std::size_t size) noexcept
+{
+  m_used -= size;
+}
+
+void string_arena::clear() noexcept
+{
+  m_current = 0;
+  m_used = 0;
+  m_filled = 0;
+}
+
+std::size_t string_arena::size() const noexcept
+{
+  return m_filled + m_used;
+}
+
+bool string_arena::owns(const char* location) const noexcept
+{
+  // std::less orders pointers into unrelated blocks
+  return std::any_of(m_blocks.begin(), m_blocks.end(), [location](block const& b) { return !std::less<>{}(location, b.data) && std::less<>{}(location, b.data + b.size); });
+}
+
+void string_arena::release() noexcept
+{
+  for (auto const& b : m_blocks)
+  {
+    m_resource->deallocate(b.data, b.size, 1);
+  }
+  m_blocks.clear();
+}
+}  // namespace lexertk
+
+#endif  //LEXERTK_STRING_ARENA_IPP
@@ -0,0 +1,66 @@
+//
+// Created by allspark on 17/10/2026.
+//
+
+#ifndef LEXERTK_SYMBOL_TABLE_HPP
+#define LEXERTK_SYMBOL_TABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <vector>
+
+namespace lexertk
+{
+enum class symbol_case : std::uint8_t
+{
+  sensitive,
+  // names equal under details::imatch share an id
+  insensitive
+};
+
+// Interns symbol names, handing out dense ids in the order the names are
+// first seen. Names are kept as views of their first occurrence, which must
+// stay alive. Open addressing over a power of two number of slots.
+class symbol_table
+{
+public:
+  using id_type = std::uint32_t;
+  static constexpr id_type npos = std::numeric_limits<id_type>::max();
+
+  inline explicit symbol_table(symbol_case sc = symbol_case::sensitive) noexcept;
+
+  // The id of name, a new one if it has not been seen before.
+  inline id_type intern(std::string_view name);
+  // The id of name, npos if it has not been seen before.
+  inline id_type find(std::string_view name) const noexcept;
+  inline std::string_view name_of(id_type id) const noexcept;
+
+  inline std::size_t size() const noexcept;
+  inline symbol_case get_case() const noexcept;
+  // Forgets all symbols, the slots are kept for reuse.
+  inline void clear() noexcept;
+
+private:
+  struct slot
+  {
+    std::uint32_t hash;
+    id_type id{npos};
+  };
+
+  inline std::uint32_t hash_of(std::string_view name) const noexcept;
+  inline bool equal(std::string_view a, std::string_view b) const noexcept;
+  // The slot holding name, or the empty one it would go into.
+  inline std::size_t slot_of(std::string_view name, std::uint32_t hash) const noexcept;
+  inline void grow();
+
+  symbol_case m_case;
+  std::vector<slot> m_slots;
+  std::vector<std::string_view> m_names;
+};
+}  // namespace lexertk
+
+#include "symbol_table.ipp"
+
+#endif  //LEXERTK_SYMBOL_TABLE_HPP
@@ -0,0 +1,115 @@
+//
+// Created by allspark on 17/10/2026.
+//
+
+#ifndef LEXERTK_SYMBOL_TABLE_IPP
+#define LEXERTK_SYMBOL_TABLE_IPP
+
+#include "detail.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <utility>
+
+namespace lexertk
+{
+symbol_table::symbol_table(symbol_case sc) noexcept
+  : m_case{sc}
+{
+}
+
+symbol_table::id_type symbol_table::intern(std::string_view name)
+{
+  // at most half of the slots are in use
+  if (2 * (m_names.size() + 1) > m_slots.size())
+  {
+    grow();
+  }
+
+  auto hash = hash_of(name);
+  auto& s = m_slots[slot_of(name, hash)];
+  if (s.id == npos)
+  {
+    s = {hash, static_cast<id_type>(m_names.size())};
+    m_names.push_back(name);
+  }
+  return s.id;
+}
+
+symbol_table::id_type symbol_table::find(std::string_view name) const noexcept
+{
+  return m_slots.empty() ? npos : m_slots[slot_of(name, hash_of(name))].id;
+}
+
+std::string_view symbol_table::name_of(id_type id) const noexcept
+{
+  return m_names[id];
+}
+
+std::size_t symbol_table::size() const noexcept
+{
+  return m_names.size();
+}
+
+symbol_case symbol_table::get_case() const noexcept
+{
+  return m_case;
+}
+
+void symbol_table::clear() noexcept
+{
+  std::fill(m_slots.begin(), m_slots.end(), slot{});
+  m_names.clear();
+}
+
+std::uint32_t symbol_table::hash_of(std::string_view name) const noexcept
+{
+  // FNV-1a, symbols are short
+  std::uint64_t hash = 0xcbf29ce484222325;
+  for (char c : name)
+  {
+    hash ^= static_cast<unsigned char>(m_case == symbol_case::insensitive ? std::tolower(c) : c);
+    hash *= 0x100000001b3;
+  }
+  return static_cast<std::uint32_t>(hash ^ (hash >> 32));
+}
+
+bool symbol_table::equal(std::string_view a, std::string_view b) const noexcept
+{
+  return m_case == symbol_case::insensitive ? details::imatch(a, b) : a == b;
+}
+
+std::size_t symbol_table::slot_of(std::string_view name, std::uint32_t hash) const noexcept
+{
+  const std::size_t mask = m_slots.size() - 1;
+  for (std::size_t i = hash & mask;; i = (i + 1) & mask)
+  {
+    auto const& s = m_slots[i];
+    if (s.id == npos || (s.hash == hash && equal(m_names[s.id], name)))
+    {
+      return i;
+    }
+  }
+}
+
+void symbol_table::grow()
+{
+  std::vector<slot> slots(m_slots.empty() ? 64 : 2 * m_slots.size());
+  const std::size_t mask = slots.size() - 1;
+  for (auto const& s : m_slots)
+  {
+    if (s.id != npos)
+    {
+      auto i = s.hash & mask;
+      while (slots[i].id != npos)
+      {
+        i = (i + 1) & mask;
+      }
+      slots[i] = s;
+    }
+  }
+  m_slots = std::move(slots);
+}
+}  // namespace lexertk
+
+#endif  //LEXERTK_SYMBOL_TABLE_IPP
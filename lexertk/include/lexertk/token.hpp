@@ -5,87 +5,81 @@
 #ifndef LEXERTK_TOKEN_HPP
 #define LEXERTK_TOKEN_HPP
 
-#include <cstdint>
-#include <limits>
+#include "position.hpp"
+
 #include <string_view>
 
 namespace lexertk
 {
-class token
+enum struct token_type : unsigned char
+{
+  none = 0,
+  error = 1,
+  err_symbol = 2,
+  err_number = 3,
+  err_string = 4,
+  err_sfunc = 5,
+  eof = 6,
+  number = 7,
+  symbol = 8,
+  string = 9,
+  string_with_escapes = 10,
+  boolean = 11,
+  shr = 12,
+  shl = 13,
+  lte = 14,
+  ne = 15,
+  gte = 16,
+  eol = 17,
+  rebind = 18,
+  eq = 19,
+  increment = 20,
+  decrement = 21,
+  scope = 22,
+  logical_and = 23,
+  logical_or = 24,
+  keyword = 25,
+  eoe = ';',
+  lt = '<',
+  gt = '>',
+  assign = '=',
+  rbracket = ')',
+  lbracket = '(',
+  rsqrbracket = ']',
+  lsqrbracket = '[',
+  rcrlbracket = '}',
+  lcrlbracket = '{',
+  comma = ',',
+  dot = '.',
+  add = '+',
+  sub = '-',
+  div = '/',
+  mul = '*',
+  mod = '%',
+  pow = '^',
+  logical_not = '!',
+  bit_and = '&',
+  bit_or = '|',
+  bit_not = '~',
+  colon = ':',
+  hash = '#'
+};
+
+// Token with its text as a view into the lexed input and its position in
+// whatever Position policy the generator should track, see position.hpp.
+template <typename PositionT>
+class basic_token
 {
 public:
   using iterator = std::string_view::const_iterator;
+  using token_type = lexertk::token_type;
+  using Position = PositionT;
 
-  enum struct token_type : unsigned char
-  {
-    none = 0,
-    error = 1,
-    err_symbol = 2,
-    err_number = 3,
-    err_string = 4,
-    err_sfunc = 5,
-    eof = 6,
-    number = 7,
-    symbol = 8,
-    string = 9,
-    string_with_escapes = 10,
-    boolean = 11,
-    shr = 12,
-    shl = 13,
-    lte = 14,
-    ne = 15,
-    gte = 16,
-    eol = 17,
-    rebind = 18,
-    eq = 19,
-    increment = 20,
-    decrement = 21,
-    scope = 22,
-    logical_and = 23,
-    logical_or = 24,
-    eoe = ';',
-    lt = '<',
-    gt = '>',
-    assign = '=',
-    rbracket = ')',
-    lbracket = '(',
-    rsqrbracket = ']',
-    lsqrbracket = '[',
-    rcrlbracket = '}',
-    lcrlbracket = '{',
-    comma = ',',
-    dot = '.',
-    add = '+',
-    sub = '-',
-    div = '/',
-    mul = '*',
-    mod = '%',
-    pow = '^',
-    logical_not = '!',
-    bit_and = '&',
-    bit_or = '|',
-    bit_not = '~',
-    colon = ':',
-    hash = '#'
-  };
-
-  struct Position
-  {
-    using value_type = std::uint16_t;
+  basic_token() = default;
 
-    value_type line{std::numeric_limits<value_type>::max()};
-    value_type column{std::numeric_limits<value_type>::max()};
-
-    inline Position IncrementColumn(iterator begin, iterator end) noexcept;
-    inline void NextLine() noexcept;
-    inline void NextColumn() noexcept;
-  };
-
-  token() = default;
-
-  inline token(token_type tt, iterator begin, iterator end, Position position) noexcept;
-  inline token(token_type tt, Position position) noexcept;
-  inline token(token_type tt, std::string_view value, Position position) noexcept;
+  inline basic_token(token_type tt, iterator begin, iterator end, Position position) noexcept;
+  inline basic_token(token_type tt, Position position) noexcept;
+  inline basic_token(token_type tt, std::string_view value, Position position) noexcept;
 
   inline bool is_error() const noexcept;
 
@@ -97,12 +91,16 @@ public:
   inline void set_value(std::string_view) noexcept;
 
 private:
-  Position m_position{};
+  [[no_unique_address]] Position m_position{};
   token_type m_type{token_type::none};
   std::string_view m_value;
 };
 
-inline std::string_view to_string(token::token_type t) noexcept;
+// 16 bit line and column
+using token = basic_token<position16>;
+
+inline bool is_error(token_type t) noexcept;
+inline std::string_view to_string(token_type t) noexcept;
 }  // namespace lexertk
 
 #include "token.ipp"
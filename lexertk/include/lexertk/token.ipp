@@ -7,179 +7,174 @@
 
 namespace lexertk
 {
-token::Position token::Position::IncrementColumn(iterator begin, iterator end) noexcept
-{
-  std::size_t off = std::distance(begin, end);
-  Position tmp{*this};
-
-  column += off;
-
-  return tmp;
-}
-
-void token::Position::NextLine() noexcept
-{
-  ++line;
-  column = 1;
-}
-
-void token::Position::NextColumn() noexcept
-{
-  ++column;
-}
-
-token::token(token_type tt, iterator begin, iterator end, Position position) noexcept
+template <typename PositionT>
+basic_token<PositionT>::basic_token(token_type tt, iterator begin, iterator end, Position position) noexcept
   : m_type{tt}
   , m_value{begin, end}
   , m_position{position}
 {
 }
 
-token::token(token_type tt, Position position) noexcept
+template <typename PositionT>
+basic_token<PositionT>::basic_token(token_type tt, Position position) noexcept
   : m_type{tt}
   , m_position{position}
 {
 }
 
-token::token(token_type tt, std::string_view value, Position position) noexcept
+template <typename PositionT>
+basic_token<PositionT>::basic_token(token_type tt, std::string_view value, Position position) noexcept
   : m_type{tt}
   , m_value{value}
   , m_position{position}
 {
 }
 
-bool token::is_error() const noexcept
+template <typename PositionT>
+bool basic_token<PositionT>::is_error() const noexcept
 {
-  return m_type == token_type::error || m_type == token_type::err_symbol || m_type == token_type::err_number || m_type == token_type::err_string;
+  return lexertk::is_error(m_type);
 }
 
-token::token_type token::get_type() const noexcept
+template <typename PositionT>
+token_type basic_token<PositionT>::get_type() const noexcept
 {
   return m_type;
 }
 
-std::string_view token::get_value() const noexcept
+template <typename PositionT>
+std::string_view basic_token<PositionT>::get_value() const noexcept
 {
   return m_value;
 }
 
-token::Position token::get_position() const noexcept
+template <typename PositionT>
+PositionT basic_token<PositionT>::get_position() const noexcept
 {
   return m_position;
 }
 
-void token::set_type(token_type t) noexcept
+template <typename PositionT>
+void basic_token<PositionT>::set_type(token_type t) noexcept
 {
   m_type = t;
 }
 
-void token::set_value(std::string_view value) noexcept
+template <typename PositionT>
+void basic_token<PositionT>::set_value(std::string_view value) noexcept
 {
   m_value = value;
 }
 
-std::string_view to_string(token::token_type t) noexcept
+bool is_error(token_type t) noexcept
+{
+  return t == token_type::error || t == token_type::err_symbol || t == token_type::err_number || t == token_type::err_string;
+}
+
+std::string_view to_string(token_type t) noexcept
 {
   switch (t)
   {
-    case token::token_type::none:
+    case token_type::none:
       return "NONE";
-    case token::token_type::error:
+    case token_type::error:
       return "ERROR";
-    case token::token_type::err_symbol:
+    case token_type::err_symbol:
       return "ERROR_SYMBOL";
-    case token::token_type::err_number:
+    case token_type::err_number:
       return "ERROR_NUMBER";
-    case token::token_type::err_string:
+    case token_type::err_string:
       return "ERROR_STRING";
-    case token::token_type::eof:
+    case token_type::eof:
       return "END_OF_FILE";
-    case token::token_type::number:
+    case token_type::number:
       return "NUMBER";
-    case token::token_type::symbol:
+    case token_type::symbol:
       return "SYMBOL";
-    case token::token_type::string:
+    case token_type::string:
       return "STRING";
-    case token::token_type::assign:
+    case token_type::assign:
       return "=";
-    case token::token_type::shr:
+    case token_type::shr:
       return ">>";
-    case token::token_type::shl:
+    case token_type::shl:
       return "<<";
-    case token::token_type::lte:
+    case token_type::lte:
       return "<=";
-    case token::token_type::ne:
+    case token_type::ne:
       return "!=";
-    case token::token_type::gte:
+    case token_type::gte:
       return ">=";
-    case token::token_type::eoe:
+    case token_type::eoe:
       return "EOE";
-    case token::token_type::lt:
+    case token_type::lt:
       return "<";
-    case token::token_type::gt:
+    case token_type::gt:
       return ">";
-    case token::token_type::eq:
+    case token_type::eq:
       return "==";
-    case token::token_type::rbracket:
+    case token_type::rbracket:
       return ")";
-    case token::token_type::lbracket:
+    case token_type::lbracket:
       return "(";
-    case token::token_type::rsqrbracket:
+    case token_type::rsqrbracket:
       return "]";
-    case token::token_type::lsqrbracket:
+    case token_type::lsqrbracket:
       return "[";
-    case token::token_type::rcrlbracket:
+    case token_type::rcrlbracket:
       return "}";
-    case token::token_type::lcrlbracket:
+    case token_type::lcrlbracket:
       return "{";
-    case token::token_type::comma:
+    case token_type::comma:
       return ",";
-    case token::token_type::add:
+    case token_type::add:
       return "+";
-    case token::token_type::sub:
+    case token_type::sub:
       return "-";
-    case token::token_type::div:
+    case token_type::div:
       return "/";
-    case token::token_type::mul:
+    case token_type::mul:
       return "*";
-    case token::token_type::mod:
+    case token_type::mod:
       return "%";
-    case token::token_type::pow:
+    case token_type::pow:
       return "^";
-    case token::token_type::colon:
+    case token_type::colon:
       return ":";
-    case token::token_type::err_sfunc:
+    case token_type::err_sfunc:
       return "ERROR_SFUNC";
-    case token::token_type::rebind:
+    case token_type::rebind:
       return ":=";
-    case token::token_type::string_with_escapes:
+    case token_type::string_with_escapes:
       return "STRING2";
-    case token::token_type::hash:
+    case token_type::hash:
       return "#";
-    case token::token_type::increment:
+    case token_type::increment:
       return "++";
-    case token::token_type::decrement:
+    case token_type::decrement:
       return "--";
-    case token::token_type::scope:
+    case token_type::scope:
       return "::";
-    case token::token_type::dot:
+    case token_type::dot:
       return ".";
-    case token::token_type::bit_and:
+    case token_type::bit_and:
       return "&";
-    case token::token_type::bit_or:
+    case token_type::bit_or:
       return "|";
-    case token::token_type::logical_not:
+    case token_type::logical_not:
       return "!";
-    case token::token_type::logical_and:
+    case token_type::logical_and:
       return "&&";
-    case token::token_type::logical_or:
+    case token_type::logical_or:
       return "||";
-    case token::token_type::bit_not:
+    case token_type::bit_not:
       return "~";
-    case token::token_type::eol:
+    case token_type::eol:
       return "END_OF_LINE";
-    case token::token_type::boolean:
+    case token_type::boolean:
       return "boolean";
+    case token_type::keyword:
+      return "KEYWORD";
   }
   return "UNKNOWN";
 }
@@ -0,0 +1,95 @@
+//
+// Created by allspark on 17/10/2026.
+//
+
+#ifndef LEXERTK_TOKEN_LIST_HPP
+#define LEXERTK_TOKEN_LIST_HPP
+
+#include "string_arena.hpp"
+#include "token.hpp"
+
+#include <cstddef>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+namespace lexertk
+{
+// The token list of generator and the helpers. Tokens are kept in a
+// std::pmr::vector, text synthesized for them by helpers in an arena that is
+// released with the list. Both allocate from the list's memory_resource.
+// The vector is a private base, members that would drop tokens without
+// their values, like the vector's own clear(), are not exposed.
+class token_list : private std::pmr::vector<token>
+{
+  using base = std::pmr::vector<token>;
+
+public:
+  using base::allocator_type;
+  using base::const_iterator;
+  using base::const_reference;
+  using base::difference_type;
+  using base::iterator;
+  using base::reference;
+  using base::size_type;
+  using base::value_type;
+
+  token_list() = default;
+  inline explicit token_list(allocator_type const& allocator);
+  template <typename InputIt>
+  inline token_list(InputIt first, InputIt last, allocator_type const& allocator = {});
+  // Values in the arena of other are copied into the arena of the new list.
+  inline token_list(token_list const& other);
+  token_list(token_list&& other) noexcept = default;
+  inline token_list& operator=(token_list const& other);
+  // The arena of other is only taken with its tokens, if other allocates
+  // from an equal memory_resource. Otherwise both are copied.
+  inline token_list& operator=(token_list&& other);
+  ~token_list() = default;
+
+  using base::at;
+  using base::back;
+  using base::begin;
+  using base::capacity;
+  using base::cbegin;
+  using base::cend;
+  using base::data;
+  using base::emplace;
+  using base::emplace_back;
+  using base::empty;
+  using base::end;
+  using base::erase;
+  using base::front;
+  using base::get_allocator;
+  using base::insert;
+  using base::operator[];
+  using base::pop_back;
+  using base::push_back;
+  using base::rbegin;
+  using base::rend;
+  using base::reserve;
+  using base::resize;
+  using base::shrink_to_fit;
+  using base::size;
+
+  // Copies text into the arena of this list, the view stays valid until the
+  // list is cleared or destroyed.
+  inline std::string_view store_value(std::string_view text);
+  // Same for text written by write(char* out) into room for max_size bytes,
+  // write returns the number of bytes it wrote.
+  template <typename Writer>
+  inline std::string_view store_value(std::size_t max_size, Writer&& write);
+  // Drops the tokens and the stored values.
+  inline void clear() noexcept;
+
+private:
+  // stores the values of other's tokens that lie in other's arena
+  inline void rehome_values(token_list const& other);
+
+  string_arena m_values{get_allocator().resource()};
+};
+}  // namespace lexertk
+
+#include "token_list.ipp"
+
+#endif  //LEXERTK_TOKEN_LIST_HPP
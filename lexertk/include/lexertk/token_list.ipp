@@ -0,0 +1,103 @@
+//
+// Created by allspark on 17/10/2026.
+//
+
+#ifndef LEXERTK_TOKEN_LIST_IPP
+#define LEXERTK_TOKEN_LIST_IPP
+
+#include <algorithm>
+#include <utility>
+
+namespace lexertk
+{
+token_list::token_list(allocator_type const& allocator)
+  : base(allocator)
+{
+}
+
+template <typename InputIt>
+token_list::token_list(InputIt first, InputIt last, allocator_type const& allocator)
+  : base(first, last, allocator)
+{
+}
+
+token_list::token_list(token_list const& other)
+  : base(other)
+{
+  rehome_values(other);
+}
+
+token_list& token_list::operator=(token_list const& other)
+{
+  if (this != &other)
+  {
+    m_values.clear();
+    base::operator=(other);
+    rehome_values(other);
+  }
+  return *this;
+}
+
+token_list& token_list::operator=(token_list&& other)
+{
+  if (this == &other)
+  {
+    return *this;
+  }
+
+  // std::pmr::vector only takes the buffer of other for equal allocators and
+  // copies the tokens otherwise, their values must follow the same way
+  if (get_allocator() == other.get_allocator())
+  {
+    base::operator=(std::move(other));
+    m_values = std::move(other.m_values);
+  }
+  else
+  {
+    m_values.clear();
+    base::operator=(std::move(other));
+    rehome_values(other);
+    other.clear();
+  }
+  return *this;
+}
+
+std::string_view token_list::store_value(std::string_view text)
+{
+  char* out = m_values.allocate(text.size());
+  std::copy(text.begin(), text.end(), out);
+  return {out, text.size()};
+}
+
+template <typename Writer>
+std::string_view token_list::store_value(std::size_t max_size, Writer&& write)
+{
+  char* out = m_values.allocate(max_size);
+  std::size_t size = std::forward<Writer>(write)(out);
+  m_values.release_tail(max_size - size);
+  return {out, size};
+}
+
+void token_list::clear() noexcept
+{
+  base::clear();
+  m_values.clear();
+}
+
+void token_list::rehome_values(token_list const& other)
+{
+  if (other.m_values.size() == 0)
+  {
+    return;
+  }
+  for (auto& t : *this)
+  {
+    if (other.m_values.owns(t.get_value().data()))
+    {
+      t.set_value(store_value(t.get_value()));
+    }
+  }
+}
+}  // namespace lexertk
+
+#endif  //LEXERTK_TOKEN_LIST_IPP